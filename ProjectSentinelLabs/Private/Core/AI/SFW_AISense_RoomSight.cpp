@@ -0,0 +1,267 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AISense_RoomSight.cpp
+
+#include "Core/AI/SFW_AISense_RoomSight.h"
+#include "Core/AI/SFW_AISenseConfig_RoomSight.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Perception/AIPerceptionComponent.h"
+
+USFW_AISense_RoomSight::USFW_AISense_RoomSight(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NotifyType = EAISenseNotifyType::OnPerceptionChange;
+	bAutoRegisterAllPawnsAsSources = false;
+
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		OnNewListenerDelegate.BindUObject(this, &USFW_AISense_RoomSight::OnNewListenerImpl);
+		OnListenerUpdateDelegate.BindUObject(this, &USFW_AISense_RoomSight::OnListenerUpdateImpl);
+		OnListenerRemovedDelegate.BindUObject(this, &USFW_AISense_RoomSight::OnListenerRemovedImpl);
+
+		TraceDelegate.BindUObject(this, &USFW_AISense_RoomSight::OnTraceDone);
+	}
+}
+
+void USFW_AISense_RoomSight::DigestConfig(const USFW_AISenseConfig_RoomSight& Config, FListenerState& OutState)
+{
+	OutState.SightRadiusSq = FMath::Square(Config.SightRadius);
+	OutState.LoseSightRadiusSq = FMath::Square(FMath::Max(Config.LoseSightRadius, Config.SightRadius));
+	OutState.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(Config.PeripheralVisionAngleDegrees));
+	OutState.MaxRoomHops = Config.MaxRoomHops;
+}
+
+void USFW_AISense_RoomSight::OnNewListenerImpl(const FPerceptionListener& NewListener)
+{
+	const UAIPerceptionComponent* Component = NewListener.Listener.Get();
+	const USFW_AISenseConfig_RoomSight* Config = Component
+		? Cast<const USFW_AISenseConfig_RoomSight>(Component->GetSenseConfig(GetSenseID()))
+		: nullptr;
+	if (Config)
+	{
+		DigestConfig(*Config, ListenerStates.FindOrAdd(NewListener.GetListenerID()));
+	}
+}
+
+void USFW_AISense_RoomSight::OnListenerUpdateImpl(const FPerceptionListener& UpdatedListener)
+{
+	if (!UpdatedListener.HasSense(GetSenseID()))
+	{
+		OnListenerRemovedImpl(UpdatedListener);
+		return;
+	}
+
+	// Keeps what was seen; only the shape changes
+	OnNewListenerImpl(UpdatedListener);
+}
+
+void USFW_AISense_RoomSight::OnListenerRemovedImpl(const FPerceptionListener& RemovedListener)
+{
+	// Its queued checks and traces in flight are dropped when they come up
+	ListenerStates.Remove(RemovedListener.GetListenerID());
+}
+
+bool USFW_AISense_RoomSight::IsInSightVolume(const FListenerState& State, const FPerceptionListener& Listener,
+	const AActor& Target, bool bCurrentlyVisible)
+{
+	const FVector ToTarget = Target.GetActorLocation() - Listener.CachedLocation;
+	const double DistSq = ToTarget.SizeSquared();
+	if (DistSq > (bCurrentlyVisible ? State.LoseSightRadiusSq : State.SightRadiusSq))
+	{
+		return false;
+	}
+
+	return DistSq <= UE_KINDA_SMALL_NUMBER
+		|| FVector::DotProduct(ToTarget / FMath::Sqrt(DistSq), Listener.CachedDirection) >= State.CosHalfAngle;
+}
+
+void USFW_AISense_RoomSight::GatherCandidates(const FPerceptionListener& Listener, const FListenerState& State,
+	TArray<APawn*>& OutCandidates) const
+{
+	const USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(GetWorld());
+	if (!Occupancy)
+	{
+		return;
+	}
+
+	const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(GetWorld());
+	const FName ListenerRoom = RoomIndex ? RoomIndex->FindRoomIdAtLocation(Listener.CachedLocation) : NAME_None;
+
+	TArray<FName> NearbyRooms;
+	if (RoomIndex && !ListenerRoom.IsNone())
+	{
+		RoomIndex->GetRoomGraph().GetRoomsWithinHops(MakeArrayView(&ListenerRoom, 1), State.MaxRoomHops, NearbyRooms);
+	}
+
+	if (NearbyRooms.Num() > 0)
+	{
+		// Safe rooms included: they only stop targeting decisions, not sight
+		for (const FName RoomId : NearbyRooms)
+		{
+			Occupancy->GetPlayerPawnsInRoom(RoomId, OutCandidates);
+		}
+	}
+	else
+	{
+		// Listener outside the room graph: the radius is the only cull
+		Occupancy->GetRoomsWithPlayers(NearbyRooms);
+		for (const FName RoomId : NearbyRooms)
+		{
+			Occupancy->GetPlayerPawnsInRoom(RoomId, OutCandidates);
+		}
+	}
+
+	// Players in no volume at all (seams, outdoors) are culled by radius only
+	Occupancy->GetPlayerPawnsOutsideRooms(OutCandidates);
+}
+
+float USFW_AISense_RoomSight::Update()
+{
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+
+	TArray<APawn*> Candidates;
+	for (TPair<FPerceptionListenerID, FListenerState>& Pair : ListenerStates)
+	{
+		const FPerceptionListener* Listener = ListenersMap.Find(Pair.Key);
+		if (!Listener || !Listener->HasSense(GetSenseID()))
+		{
+			continue;
+		}
+
+		FListenerState& State = Pair.Value;
+
+		Candidates.Reset();
+		GatherCandidates(*Listener, State, Candidates);
+
+		// Targets that are no longer candidates are lost without a trace, and any
+		// trace still in flight for them is discarded when it returns
+		for (auto It = State.Targets.CreateIterator(); It; ++It)
+		{
+			AActor* Target = It.Key().Get();
+			FTargetState& TargetState = It.Value();
+			if (!Target)
+			{
+				It.RemoveCurrent();
+			}
+			else if ((TargetState.bVisible || TargetState.bPending) && !Candidates.Contains(Target))
+			{
+				++TargetState.Generation;
+				TargetState.bPending = false;
+				if (TargetState.bVisible)
+				{
+					ReportTarget(Pair.Key, TargetState, *Target, false);
+				}
+			}
+		}
+
+		for (APawn* Candidate : Candidates)
+		{
+			if (Candidate == Listener->GetBodyActor())
+			{
+				continue;
+			}
+
+			FTargetState& TargetState = State.Targets.FindOrAdd(Candidate);
+			if (TargetState.bPending)
+			{
+				continue;
+			}
+
+			if (!IsInSightVolume(State, *Listener, *Candidate, TargetState.bVisible))
+			{
+				if (TargetState.bVisible)
+				{
+					ReportTarget(Pair.Key, TargetState, *Candidate, false);
+				}
+				continue;
+			}
+
+			TargetState.bPending = true;
+			CheckQueue.Add({ Pair.Key, Candidate, TargetState.Generation });
+		}
+	}
+
+	IssueTraces();
+
+	// Every perception tick
+	return 0.f;
+}
+
+void USFW_AISense_RoomSight::IssueTraces()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	AIPerception::FListenerMap& ListenersMap = *GetListeners();
+
+	int32 Consumed = 0;
+	int32 Issued = 0;
+	for (; Consumed < CheckQueue.Num() && Issued < MaxTracesPerTick; ++Consumed)
+	{
+		const FSightCheck& Check = CheckQueue[Consumed];
+		const FPerceptionListener* Listener = ListenersMap.Find(Check.ListenerId);
+		const AActor* Target = Check.Target.Get();
+		if (!Listener || !Target || !ListenerStates.Contains(Check.ListenerId))
+		{
+			continue; // stale, costs no budget
+		}
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(SFWRoomSight), false, Listener->GetBodyActor());
+		Params.AddIgnoredActor(Target);
+
+		NextTicket = FMath::Max(NextTicket + 1, 1u);
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Listener->CachedLocation, Target->GetActorLocation(),
+			ECC_Visibility, Params, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, NextTicket);
+
+		InFlight.Add(NextTicket, Check);
+		++Issued;
+	}
+
+	CheckQueue.RemoveAt(0, Consumed, EAllowShrinking::No);
+}
+
+void USFW_AISense_RoomSight::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	FSightCheck Check;
+	if (!InFlight.RemoveAndCopyValue(Datum.UserData, Check))
+	{
+		return;
+	}
+
+	FListenerState* State = ListenerStates.Find(Check.ListenerId);
+	FTargetState* TargetState = State ? State->Targets.Find(Check.Target) : nullptr;
+	AActor* Target = Check.Target.Get();
+	if (!TargetState || !Target || TargetState->Generation != Check.Generation)
+	{
+		return; // target dropped (and possibly re-queued) since this trace started
+	}
+
+	TargetState->bPending = false;
+
+	// The target itself is ignored, so any blocking hit is an occluder. Every success is
+	// reported, like stock sight, so the stimulus age resets while the target stays in view;
+	// a loss only on the change.
+	const bool bVisible = !(Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit);
+	if (bVisible || TargetState->bVisible)
+	{
+		ReportTarget(Check.ListenerId, *TargetState, *Target, bVisible);
+	}
+}
+
+void USFW_AISense_RoomSight::ReportTarget(const FPerceptionListenerID& ListenerId, FTargetState& TargetState, AActor& Target, bool bVisible)
+{
+	TargetState.bVisible = bVisible;
+
+	if (FPerceptionListener* Listener = GetListeners()->Find(ListenerId))
+	{
+		Listener->RegisterStimulus(&Target, FAIStimulus(*this, 1.f, Target.GetActorLocation(), Listener->CachedLocation,
+			bVisible ? FAIStimulus::SensingSucceeded : FAIStimulus::SensingFailed));
+	}
+}
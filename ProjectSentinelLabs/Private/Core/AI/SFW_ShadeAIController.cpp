@@ -2,12 +2,15 @@
 
 #include "Core/AI/SFW_ShadeAIController.h"
 #include "Core/AI/SFW_ShadeCharacterBase.h"
+#include "Core/AI/SFW_AISenseConfig_RoomSight.h"
 #include "Core/Game/SFW_GameState.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 #include "Core/Rooms/RoomVolume.h"
-#include "Core/Actors/SFW_DoorBase.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/SFW_RoomPathCacheSubsystem.h"
+#include "Core/Rooms/SFW_RoomPatrolPointsSubsystem.h"
 
 #include "Perception/AIPerceptionComponent.h"
-#include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AIPerceptionTypes.h"
 
 #include "Kismet/GameplayStatics.h"
@@ -23,22 +26,20 @@
 ASFW_ShadeAIController::ASFW_ShadeAIController()
 {
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false; // see SetAIState
 
 	// --- Perception setup ---
 	Perception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("Perception"));
-	SightConfig = CreateDefaultSubobject<UAISenseConfig_Sight>(TEXT("SightConfig"));
+	SightConfig = CreateDefaultSubobject<USFW_AISenseConfig_RoomSight>(TEXT("SightConfig"));
 
 	if (SightConfig)
 	{
 		SightConfig->SightRadius = 1500.f;
 		SightConfig->LoseSightRadius = 1800.f;
 		SightConfig->PeripheralVisionAngleDegrees = 60.f;
+		SightConfig->MaxRoomHops = 1;
 		SightConfig->SetMaxAge(2.0f);
 
-		SightConfig->DetectionByAffiliation.bDetectEnemies = true;
-		SightConfig->DetectionByAffiliation.bDetectFriendlies = true;
-		SightConfig->DetectionByAffiliation.bDetectNeutrals = true;
-
 		Perception->ConfigureSense(*SightConfig);
 		Perception->SetDominantSense(SightConfig->GetSenseImplementation());
 	}
@@ -68,9 +69,21 @@ void ASFW_ShadeAIController::OnPossess(APawn* InPawn)
 	Shade = Cast<ASFW_ShadeCharacterBase>(InPawn);
 	AIState = EShadeAIState::Patrol;
 	TravelRetryCount = 0;
-	NextDoorCheckTime = 0.0;
 	GetWorldTimerManager().ClearTimer(TravelRetryHandle);
 
+	if (Shade)
+	{
+		Shade->OnRoomChanged.AddUObject(this, &ASFW_ShadeAIController::OnShadeRoomChanged);
+	}
+
+#if ENABLE_DRAW_DEBUG
+	// Draw at the debug shapes' lifetime so they stay visible without ticking
+	if (bDebugDrawPath)
+	{
+		GetWorldTimerManager().SetTimer(DebugDrawHandle, this, &ASFW_ShadeAIController::DebugDrawShade, 0.15f, true);
+	}
+#endif
+
 	// === Early-game: make Shade "ethereal" (invisible + no player collision) ===
 	if (ACharacter* Char = Cast<ACharacter>(InPawn))
 	{
@@ -132,31 +145,63 @@ void ASFW_ShadeAIController::OnPossess(APawn* InPawn)
 	}
 }
 
-void ASFW_ShadeAIController::Tick(float DeltaSeconds)
+void ASFW_ShadeAIController::OnUnPossess()
 {
-	Super::Tick(DeltaSeconds);
+	if (Shade)
+	{
+		Shade->OnRoomChanged.RemoveAll(this);
+	}
 
-	if (!Shade) return;
+	CancelTravelPathQuery();
+	GetWorldTimerManager().ClearTimer(StateUpdateHandle);
+	GetWorldTimerManager().ClearTimer(DebugDrawHandle);
+	SetActorTickEnabled(false);
 
-	// Debug draw even when Shade is invisible so we can see what it's doing
-	DebugDrawShade();
+	Super::OnUnPossess();
+}
 
-	// While traveling to Rift, periodically check for a blocking door in front
-	if (AIState == EShadeAIState::TravelToRift)
+// ======================================================
+// State machine
+// ======================================================
+
+void ASFW_ShadeAIController::SetAIState(EShadeAIState NewState)
+{
+	AIState = NewState;
+
+	GetWorldTimerManager().ClearTimer(StateUpdateHandle);
+
+	const float Interval = GetStateUpdateInterval(NewState);
+	if (Interval > 0.f)
 	{
-		if (UWorld* World = GetWorld())
-		{
-			const double Now = World->GetTimeSeconds();
-			if (Now >= NextDoorCheckTime)
-			{
-				TryResolveDoorBlockage();
-				NextDoorCheckTime = Now + DoorCheckInterval;
-			}
-		}
+		GetWorldTimerManager().SetTimer(StateUpdateHandle, this, &ASFW_ShadeAIController::UpdateState, Interval, true);
 	}
 
-	if (AIState == EShadeAIState::Chase && TargetActor)
+	// Tick only drives control rotation towards the focus, which only Chase sets
+	SetActorTickEnabled(NewState == EShadeAIState::Chase);
+}
+
+float ASFW_ShadeAIController::GetStateUpdateInterval(EShadeAIState State) const
+{
+	switch (State)
+	{
+	case EShadeAIState::Chase:        return ChaseUpdateInterval;
+
+	// Travel and patrol legs are move-result driven (doors open from their nav links),
+	// patrol waits and the Search window are timers
+	default:                          return 0.f;
+	}
+}
+
+void ASFW_ShadeAIController::UpdateState()
+{
+	if (!Shade) return;
+
+	switch (AIState)
+	{
+	case EShadeAIState::Chase:
 	{
+		if (!TargetActor) break;
+
 		const FVector ShadeLoc = Shade->GetActorLocation();
 		const FVector TargetLoc = TargetActor->GetActorLocation();
 
@@ -167,7 +212,47 @@ void ASFW_ShadeAIController::Tick(float DeltaSeconds)
 		{
 			TryAttackTarget();
 		}
+		break;
+	}
+
+	default:
+		break;
+	}
+}
+
+void ASFW_ShadeAIController::OnShadeRoomChanged(FName PrevRoomId, FName NewRoomId)
+{
+	if (AIState == EShadeAIState::TravelToRift && RiftRoom && !NewRoomId.IsNone() && NewRoomId == RiftRoom->RoomId)
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[ShadeAI] Entered Rift room '%s', ending TravelToRift"),
+			*NewRoomId.ToString());
+
+		OnReachedRift();
+	}
+}
+
+void ASFW_ShadeAIController::OnReachedRift()
+{
+	UE_LOG(LogTemp, Warning,
+		TEXT("[ShadeAI] Reached Rift, switching to Patrol at RiftCenter=%s"),
+		*RiftCenter.ToString());
+
+	if (!RiftCenter.IsNearlyZero())
+	{
+		PatrolCenter = RiftCenter;
+
+		if (Shade)
+		{
+			Shade->InitializeHome(RiftCenter);
+		}
 	}
+
+	// Successful arrival; clear retries
+	TravelRetryCount = 0;
+	GetWorldTimerManager().ClearTimer(TravelRetryHandle);
+
+	EnterPatrol();
 }
 
 // ======================================================
@@ -176,6 +261,7 @@ void ASFW_ShadeAIController::Tick(float DeltaSeconds)
 
 void ASFW_ShadeAIController::DebugDrawShade() const
 {
+#if ENABLE_DRAW_DEBUG
 	if (!bDebugDrawPath) return;
 	if (!Shade) return;
 
@@ -235,75 +321,9 @@ void ASFW_ShadeAIController::DebugDrawShade() const
 			1.5f
 		);
 	}
+#endif
 }
 
-// ======================================================
-// Door handling while traveling
-// ======================================================
-
-void ASFW_ShadeAIController::TryResolveDoorBlockage()
-{
-	if (!Shade) return;
-
-	UWorld* World = GetWorld();
-	if (!World) return;
-
-	const FVector Start = Shade->GetActorLocation();
-	FVector Forward = Shade->GetActorForwardVector();
-	if (!Forward.Normalize())
-	{
-		return;
-	}
-
-	const FVector End = Start + Forward * DoorProbeDistance;
-
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(ShadeDoorProbe), false, Shade);
-	Params.AddIgnoredActor(this);
-
-	FHitResult Hit;
-	if (!World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params))
-	{
-		return;
-	}
-
-	ASFW_DoorBase* Door = nullptr;
-
-	if (AActor* HitActor = Hit.GetActor())
-	{
-		Door = Cast<ASFW_DoorBase>(HitActor);
-
-		if (!Door)
-		{
-			if (UPrimitiveComponent* HitComp = Hit.GetComponent())
-			{
-				Door = Cast<ASFW_DoorBase>(HitComp->GetOwner());
-			}
-		}
-	}
-
-	if (!Door)
-	{
-		return;
-	}
-
-	UE_LOG(LogTemp, Warning,
-		TEXT("[ShadeAI] TryResolveDoorBlockage: Found door %s, calling OpenDoor()"),
-		*Door->GetName());
-
-	// If it's not locked, open it so the Shade can pass.
-	if (!Door->IsLocked())
-	{
-		Door->OpenDoor();
-	}
-
-	// IMPORTANT:
-	// Do NOT call EnterTravelToRift() here.
-	// Reissuing MoveToLocation would abort the current request and
-	// spam Result=Aborted; the existing move will keep running, and
-	// if the path still fails, OnMoveCompleted will schedule a retry.
-}
-
-
 // ======================================================
 // Perception
 // ======================================================
@@ -370,13 +390,48 @@ void ASFW_ShadeAIController::MoveToNextPatrolPoint()
 	UWorld* World = GetWorld();
 	if (!World) return;
 
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
-	if (!NavSys) return;
-
 	const FVector Center = PatrolCenter.IsNearlyZero()
 		? Shade->GetActorLocation()
 		: PatrolCenter;
 
+	// Baked points of the patrolled room: no nav query per leg
+	const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(World);
+	const FName RoomId = RoomIndex ? RoomIndex->FindRoomIdAtLocation(Center) : NAME_None;
+	const USFW_RoomPatrolPointsSubsystem* PatrolPoints = USFW_RoomPatrolPointsSubsystem::Get(World);
+	const TConstArrayView<FVector> RoomPoints = PatrolPoints ? PatrolPoints->GetPatrolPoints(RoomId) : TConstArrayView<FVector>();
+
+	if (RoomId != PatrolRoomId)
+	{
+		PatrolRoomId = RoomId;
+		CurrentGoalIndex = INDEX_NONE;
+	}
+
+	if (RoomPoints.Num() > 0)
+	{
+		FRandomStream& Stream = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Patrol);
+
+		// Never the point we're standing on
+		int32 Index = Stream.RandHelper(RoomPoints.Num());
+		if (RoomPoints.IsValidIndex(CurrentGoalIndex) && RoomPoints.Num() > 1)
+		{
+			Index = Stream.RandHelper(RoomPoints.Num() - 1);
+			Index += (Index >= CurrentGoalIndex) ? 1 : 0;
+		}
+		CurrentGoalIndex = Index;
+
+		bPatrolLegActive = true;
+
+		UE_LOG(LogTemp, Verbose,
+			TEXT("[ShadeAI] Patrol: Moving to point %d/%d of %s at %s"),
+			Index, RoomPoints.Num(), *RoomId.ToString(), *RoomPoints[Index].ToString());
+
+		MoveToLocation(RoomPoints[Index]);
+		return;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys) return;
+
 	FNavLocation Dest;
 	if (!NavSys->GetRandomReachablePointInRadius(Center, PatrolRadius, Dest))
 	{
@@ -388,7 +443,6 @@ void ASFW_ShadeAIController::MoveToNextPatrolPoint()
 	}
 
 	bPatrolLegActive = true;
-	CurrentGoalIndex++; // just for debug bookkeeping if needed
 
 	UE_LOG(LogTemp, Verbose,
 		TEXT("[ShadeAI] Patrol: Moving to %s (Center=%s Radius=%.1f)"),
@@ -424,6 +478,12 @@ void ASFW_ShadeAIController::OnMoveCompleted(FAIRequestID RequestID, const FPath
 {
 	Super::OnMoveCompleted(RequestID, Result);
 
+	// Superseded by a move we just issued ourselves; not a path outcome
+	if (Result.HasFlag(FPathFollowingResultFlags::NewRequest))
+	{
+		return;
+	}
+
 	// --- Travel to Rift handling ---
 	if (AIState == EShadeAIState::TravelToRift)
 	{
@@ -433,25 +493,7 @@ void ASFW_ShadeAIController::OnMoveCompleted(FAIRequestID RequestID, const FPath
 
 		if (Result.Code == EPathFollowingResult::Success)
 		{
-			UE_LOG(LogTemp, Warning,
-				TEXT("[ShadeAI] Reached Rift, switching to Patrol at RiftCenter=%s"),
-				*RiftCenter.ToString());
-
-			if (!RiftCenter.IsNearlyZero())
-			{
-				PatrolCenter = RiftCenter;
-
-				if (Shade)
-				{
-					Shade->InitializeHome(RiftCenter);
-				}
-			}
-
-			// Successful arrival; clear retries
-			TravelRetryCount = 0;
-			GetWorldTimerManager().ClearTimer(TravelRetryHandle);
-
-			EnterPatrol();
+			OnReachedRift();
 		}
 		else
 		{
@@ -462,38 +504,13 @@ void ASFW_ShadeAIController::OnMoveCompleted(FAIRequestID RequestID, const FPath
 				Code,
 				*FallbackLoc.ToString());
 
-			if (UWorld* World = GetWorld())
+			// The corridor we were following may be stale where we got stuck
+			if (USFW_RoomPathCacheSubsystem* Paths = USFW_RoomPathCacheSubsystem::Get(this))
 			{
-				if (TravelRetryCount < MaxTravelRetries)
-				{
-					TravelRetryCount++;
-					UE_LOG(LogTemp, Warning,
-						TEXT("[ShadeAI] Scheduling TravelToRift retry %d in %.2f sec"),
-						TravelRetryCount,
-						TravelRetryDelay);
-
-					World->GetTimerManager().SetTimer(
-						TravelRetryHandle,
-						this,
-						&ASFW_ShadeAIController::EnterTravelToRift,
-						TravelRetryDelay,
-						false
-					);
-				}
-				else
-				{
-					UE_LOG(LogTemp, Warning,
-						TEXT("[ShadeAI] MaxTravelRetries reached, giving up and patrolling Base at %s"),
-						*FallbackLoc.ToString());
-
-					if (PatrolCenter.IsNearlyZero())
-					{
-						PatrolCenter = FallbackLoc;
-					}
-
-					EnterPatrol();
-				}
+				Paths->InvalidateNear(FallbackLoc, USFW_RoomPathCacheSubsystem::DoorInvalidateRadius);
 			}
+
+			ScheduleTravelRetry();
 		}
 		return;
 	}
@@ -545,28 +562,21 @@ void ASFW_ShadeAIController::EnterTravelToRift()
 		return;
 	}
 
-	FVector Dest = RiftCenter;
+	USFW_RoomPathCacheSubsystem* Paths = USFW_RoomPathCacheSubsystem::Get(this);
+	const FName RiftRoomId = RiftRoom ? RiftRoom->RoomId : NAME_None;
 
-	// Project RiftCenter to the NavMesh
-	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World))
+	// Project RiftCenter to the NavMesh (once per room; the cache keeps it)
+	FVector Dest = RiftCenter;
+	if (!Paths || !Paths->GetRoomAnchor(RiftRoomId, RiftCenter, Dest))
 	{
-		FNavLocation Projected;
-		// Box extent gives us some room to find nearby nav
-		if (NavSys->ProjectPointToNavigation(RiftCenter, Projected, FVector(500.f, 500.f, 500.f)))
-		{
-			Dest = Projected.Location;
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning,
-				TEXT("[ShadeAI] EnterTravelToRift: ProjectPointToNavigation failed for %s, falling back to Patrol"),
-				*RiftCenter.ToString());
-			EnterPatrol();
-			return;
-		}
+		UE_LOG(LogTemp, Warning,
+			TEXT("[ShadeAI] EnterTravelToRift: ProjectPointToNavigation failed for %s, falling back to Patrol"),
+			*RiftCenter.ToString());
+		EnterPatrol();
+		return;
 	}
 
-	AIState = EShadeAIState::TravelToRift;
+	SetAIState(EShadeAIState::TravelToRift);
 
 	UE_LOG(LogTemp, Warning,
 		TEXT("[ShadeAI] EnterTravelToRift: Moving to NavDest=%s (OriginalRiftCenter=%s, AcceptanceRadius=%.1f)"),
@@ -583,12 +593,98 @@ void ASFW_ShadeAIController::EnterTravelToRift()
 	StopMovement();
 	ClearFocus(EAIFocusPriority::Gameplay);
 
-	MoveToLocation(Dest, TravelAcceptanceRadius, true, true, true, true);
+	// Path is found off the game thread (or reused from the cache); OnTravelPathReady starts the move
+	CancelTravelPathQuery();
+	TravelPathQueryId = Paths->RequestPath(Shade, Shade->GetCurrentRoomId(), RiftRoomId,
+		Shade->GetActorLocation(), Dest,
+		FSFWOnRoomPathReady::CreateUObject(this, &ASFW_ShadeAIController::OnTravelPathReady));
+}
+
+void ASFW_ShadeAIController::OnTravelPathReady(FNavPathSharedPtr Path)
+{
+	TravelPathQueryId = 0;
+
+	if (AIState != EShadeAIState::TravelToRift)
+	{
+		return;
+	}
+
+	if (!Path.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[ShadeAI] OnTravelPathReady: No path to Rift"));
+		ScheduleTravelRetry();
+		return;
+	}
+
+	// Door locks change nav link areas; let the path re-plan around them
+	Path->EnableRecalculationOnInvalidation(true);
+
+	FAIMoveRequest MoveReq(Path->GetEndLocation());
+	MoveReq.SetAcceptanceRadius(TravelAcceptanceRadius);
+	MoveReq.SetReachTestIncludesAgentRadius(true);
+	MoveReq.SetCanStrafe(true);
+
+	if (!RequestMove(MoveReq, Path).IsValid())
+	{
+		ScheduleTravelRetry();
+	}
+}
+
+void ASFW_ShadeAIController::ScheduleTravelRetry()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	if (TravelRetryCount < MaxTravelRetries)
+	{
+		// Exponential backoff, so a Rift that stays unreachable isn't re-queried every second
+		const float Delay = FMath::Min(TravelRetryDelay * FMath::Pow(2.f, static_cast<float>(TravelRetryCount)), MaxTravelRetryDelay);
+		TravelRetryCount++;
+
+		UE_LOG(LogTemp, Warning,
+			TEXT("[ShadeAI] Scheduling TravelToRift retry %d in %.2f sec"),
+			TravelRetryCount,
+			Delay);
+
+		World->GetTimerManager().SetTimer(
+			TravelRetryHandle,
+			this,
+			&ASFW_ShadeAIController::EnterTravelToRift,
+			Delay,
+			false
+		);
+	}
+	else
+	{
+		const FVector FallbackLoc = Shade ? Shade->GetActorLocation() : FVector::ZeroVector;
+
+		UE_LOG(LogTemp, Warning,
+			TEXT("[ShadeAI] MaxTravelRetries reached, giving up and patrolling Base at %s"),
+			*FallbackLoc.ToString());
+
+		if (PatrolCenter.IsNearlyZero())
+		{
+			PatrolCenter = FallbackLoc;
+		}
+
+		EnterPatrol();
+	}
+}
+
+void ASFW_ShadeAIController::CancelTravelPathQuery()
+{
+	if (TravelPathQueryId == 0) return;
+
+	if (USFW_RoomPathCacheSubsystem* Paths = USFW_RoomPathCacheSubsystem::Get(this))
+	{
+		Paths->CancelRequest(TravelPathQueryId);
+	}
+	TravelPathQueryId = 0;
 }
 
 void ASFW_ShadeAIController::EnterPatrol()
 {
-	AIState = EShadeAIState::Patrol;
+	SetAIState(EShadeAIState::Patrol);
 
 	UE_LOG(LogTemp, Warning,
 		TEXT("[ShadeAI] EnterPatrol: Center=%s Radius=%.1f"),
@@ -611,8 +707,8 @@ void ASFW_ShadeAIController::EnterChase(AActor* NewTarget)
 {
 	if (!NewTarget || !Shade) return;
 
-	AIState = EShadeAIState::Chase;
 	TargetActor = NewTarget;
+	SetAIState(EShadeAIState::Chase);
 
 	UE_LOG(LogTemp, Warning,
 		TEXT("[ShadeAI] EnterChase: Target=%s"), *NewTarget->GetName());
@@ -636,7 +732,7 @@ void ASFW_ShadeAIController::EnterSearch(const FVector& LastKnown)
 {
 	if (!GetWorld() || !Shade) return;
 
-	AIState = EShadeAIState::Search;
+	SetAIState(EShadeAIState::Search);
 	LastKnownPos = LastKnown;
 
 	UE_LOG(LogTemp, Warning,
@@ -6,8 +6,10 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Pawn.h"
 #include "Net/UnrealNetwork.h"
-#include "EngineUtils.h"
 #include "Core/Rooms/RoomVolume.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
 
 ASFW_ShadeCharacterBase::ASFW_ShadeCharacterBase()
 {
@@ -60,6 +62,21 @@ void ASFW_ShadeCharacterBase::BeginPlay()
     {
         RefreshCurrentRoomFromWorld();
     }
+
+    if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+    {
+        Registry->RegisterShade(this);
+    }
+}
+
+void ASFW_ShadeCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+    {
+        Registry->UnregisterShade(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ASFW_ShadeCharacterBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -206,9 +223,24 @@ void ASFW_ShadeCharacterBase::SetCurrentRoom(ARoomVolume* NewRoom)
         return;
     }
 
+    const FName PrevRoomId = CurrentRoomId;
     CurrentRoomVolume = NewRoom;
     CurrentRoomId = (NewRoom ? NewRoom->RoomId : NAME_None);
 
+    // Decisions target the Shade's room; let a sleeping decision system know.
+    if (CurrentRoomId != PrevRoomId)
+    {
+        if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+        {
+            if (ASFW_AnomalyDecisionSystem* Sys = Registry->GetDecisionSystem())
+            {
+                Sys->WakeDecisions();
+            }
+        }
+
+        OnRoomChanged.Broadcast(PrevRoomId, CurrentRoomId);
+    }
+
     // Optional debug:
     // UE_LOG(LogTemp, Verbose, TEXT("[Shade] %s now in room '%s'"),
     //     *GetName(), *CurrentRoomId.ToString());
@@ -221,35 +253,13 @@ void ASFW_ShadeCharacterBase::RefreshCurrentRoomFromWorld()
         return;
     }
 
-    UWorld* World = GetWorld();
-    if (!World)
+    const USFW_RoomIndexSubsystem* Index = USFW_RoomIndexSubsystem::Get(this);
+    if (!Index)
     {
         return;
     }
 
-    ARoomVolume* FoundRoom = nullptr;
-    const FVector Loc = GetActorLocation();
-
-    for (TActorIterator<ARoomVolume> It(World); It; ++It)
-    {
-        ARoomVolume* Vol = *It;
-        if (!Vol || Vol->RoomId.IsNone())
-        {
-            continue;
-        }
-
-        FVector Origin, Extent;
-        Vol->GetActorBounds(true, Origin, Extent);
-        const FBox Box(Origin - Extent, Origin + Extent);
-
-        if (Box.IsInside(Loc))
-        {
-            FoundRoom = Vol;
-            break;
-        }
-    }
-
-    SetCurrentRoom(FoundRoom);
+    SetCurrentRoom(Index->FindRoomAtLocation(GetActorLocation()));
 }
 
 void ASFW_ShadeCharacterBase::NotifyActorBeginOverlap(AActor* OtherActor)
@@ -281,7 +291,11 @@ void ASFW_ShadeCharacterBase::NotifyActorEndOverlap(AActor* OtherActor)
         // Only clear if were leaving the room we think were in.
         if (Room == CurrentRoomVolume)
         {
-            SetCurrentRoom(nullptr);
+            // May still be inside a neighbouring / nested volume: resolve it first so
+            // the change is set (and broadcast) once, not via NAME_None.
+            const USFW_RoomIndexSubsystem* Index = USFW_RoomIndexSubsystem::Get(this);
+            ARoomVolume* NextRoom = Index ? Index->FindRoomAtLocation(GetActorLocation()) : nullptr;
+            SetCurrentRoom(NextRoom != Room ? NextRoom : nullptr);
         }
     }
 }
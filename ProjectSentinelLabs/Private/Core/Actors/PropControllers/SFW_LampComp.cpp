@@ -4,8 +4,8 @@
 #include "Core/Actors/PropControllers/SFW_LampComp.h"
 
 #include "Net/UnrealNetwork.h"
-#include "EngineUtils.h"
 #include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
 
 USFW_LampComp::USFW_LampComp()
 {
@@ -17,24 +17,27 @@ void USFW_LampComp::BeginPlay()
 {
 	Super::BeginPlay();
 
-	bool bBound = false;
-	for (TActorIterator<ASFW_AnomalyDecisionSystem> It(GetWorld()); It; ++It)
-	{
-		if (ASFW_AnomalyDecisionSystem* Sys = *It)
-		{
-			Sys->OnDecisionBP.AddDynamic(this, &USFW_LampComp::HandleDecisionBP);
-			bBound = true;
-			break;
-		}
-	}
-
 	UE_LOG(LogTemp, Warning,
-		TEXT("[LampComp] %s BeginPlay RoomId=%s BoundToDecisionSystem=%d Role=%d"),
+		TEXT("[LampComp] %s BeginPlay RoomId=%s Role=%d"),
 		*GetOwner()->GetName(),
 		*OwningRoomId.ToString(),
-		bBound ? 1 : 0,
 		(int32)GetOwnerRole());
 
+	// Routed: only LampFlicker for our own room reaches HandleDecisionBP.
+	// The decision system may begin play after us (or replicate in later on clients).
+	if (!OwningRoomId.IsNone())
+	{
+		if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+		{
+			Registry->WhenDecisionSystemReady(FSFWOnDecisionSystemReady::FDelegate::CreateWeakLambda(this,
+				[this](ASFW_AnomalyDecisionSystem* Sys)
+				{
+					Sys->SubscribeToDecisionMulticast(OwningRoomId, ESFWDecision::LampFlicker,
+						FSFWOnDecision::FDelegate::CreateUObject(this, &USFW_LampComp::HandleDecisionBP));
+				}));
+		}
+	}
+
 	if (GetOwnerRole() == ROLE_Authority)
 	{
 		RecomputeMode();
@@ -45,6 +48,19 @@ void USFW_LampComp::BeginPlay()
 	}
 }
 
+void USFW_LampComp::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+	{
+		if (ASFW_AnomalyDecisionSystem* Sys = Registry->GetDecisionSystem())
+		{
+			Sys->UnsubscribeFromDecisions(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void USFW_LampComp::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -6,14 +6,20 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/BoxComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
-#include "EngineUtils.h"
+#include "NavLinkCustomComponent.h"
+#include "NavModifierComponent.h"
+#include "NavAreas/NavArea_Default.h"
+#include "NavAreas/NavArea_Null.h"
 
 #include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
 #include "Core/Game/SFW_GameState.h"
 #include "Core/AI/Scares/SFW_DoorScareFX.h"
 #include "Core/AI/SFW_ShadeCharacterBase.h"
+#include "Core/Rooms/SFW_RoomPathCacheSubsystem.h"
 
 ASFW_DoorBase::ASFW_DoorBase()
 {
@@ -54,6 +60,16 @@ ASFW_DoorBase::ASFW_DoorBase()
 
 	ScareFXAnchor = CreateDefaultSubobject<USceneComponent>(TEXT("ScareFXAnchor"));
 	ScareFXAnchor->SetupAttachment(Frame);
+
+	// Doorway is walkable only through the link (none of the door's primitives affect
+	// navigation, so the modifier uses its failsafe box)
+	DoorwayNavModifier = CreateDefaultSubobject<UNavModifierComponent>(TEXT("DoorwayNavModifier"));
+	DoorwayNavModifier->SetAreaClass(UNavArea_Null::StaticClass());
+
+	NavLink = CreateDefaultSubobject<UNavLinkCustomComponent>(TEXT("NavLink"));
+	NavLink->SetEnabledArea(UNavArea_Default::StaticClass());
+
+	LockedNavArea = UNavArea_Null::StaticClass();
 }
 
 void ASFW_DoorBase::OnConstruction(const FTransform& Transform)
@@ -70,6 +86,82 @@ void ASFW_DoorBase::OnConstruction(const FTransform& Transform)
 	const float Yaw = (InitialState == EDoorState::Open) ? OpenYaw : ClosedYaw;
 	SnapTo(Yaw);
 	State = InitialState;
+
+	FitDoorwayNav();
+
+	if (DoorwayNavModifier)
+	{
+		DoorwayNavModifier->FailsafeExtent = DoorwayNavExtent;
+	}
+
+	if (NavLink)
+	{
+		NavLink->SetLinkData(NavLinkStart, NavLinkEnd, ENavLinkDirection::BothWays);
+		NavLink->SetDisabledArea(LockedNavArea);
+	}
+}
+
+void ASFW_DoorBase::FitDoorwayNav()
+{
+	// Runs on every construction (each drag / edit in the editor), so its checks log at Verbose
+	const UStaticMesh* Mesh = Door ? Door->GetStaticMesh() : nullptr;
+	if (bFitNavToDoor && Mesh)
+	{
+		// Leaf bounds in the actor's space with the door shut, whatever pose it was built in
+		FRotator ClosedRot = Door->GetRelativeRotation();
+		ClosedRot.Yaw = ClosedYaw;
+		const FBox Leaf = Mesh->GetBoundingBox().TransformBy(
+			FTransform(ClosedRot, Door->GetRelativeLocation(), Door->GetRelativeScale3D()));
+
+		// The modifier's box is centred on the actor, so it has to reach the far side of the leaf
+		auto AbsMax = [](double A, double B) { return FMath::Max(FMath::Abs(A), FMath::Abs(B)); };
+		DoorwayNavExtent = FVector(
+			FMath::Max(AbsMax(Leaf.Min.X, Leaf.Max.X), static_cast<double>(DoorwayNavMinDepth)),
+			AbsMax(Leaf.Min.Y, Leaf.Max.Y),
+			AbsMax(Leaf.Min.Z, Leaf.Max.Z));
+
+		// Across the middle of the opening, at floor level
+		const double LinkX = DoorwayNavExtent.X + NavLinkClearance;
+		NavLinkStart = FVector(-LinkX, Leaf.GetCenter().Y, Leaf.Min.Z);
+		NavLinkEnd = FVector(LinkX, Leaf.GetCenter().Y, Leaf.Min.Z);
+
+		if (Leaf.GetSize().X > Leaf.GetSize().Y)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("[Door] %s: leaf is wider along X than Y; the nav link crosses along local X, so it may run along the wall."),
+				*GetName());
+		}
+		return;
+	}
+
+	if (bFitNavToDoor)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[Door] %s: no Door mesh to fit navigation to; using DoorwayNavExtent and NavLinkStart/End as set."),
+			*GetName());
+	}
+
+	// Hand-set values: each link end must be outside the cutout, on opposite sides
+	const bool bStartOutside = FMath::Abs(NavLinkStart.X) > DoorwayNavExtent.X;
+	const bool bEndOutside = FMath::Abs(NavLinkEnd.X) > DoorwayNavExtent.X;
+	if (!bStartOutside || !bEndOutside || NavLinkStart.X * NavLinkEnd.X >= 0.0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[Door] %s: NavLinkStart/End (X %.0f, %.0f) should sit on opposite sides outside the doorway cutout (X +-%.0f); AI may not path through."),
+			*GetName(), NavLinkStart.X, NavLinkEnd.X, DoorwayNavExtent.X);
+	}
+}
+
+namespace
+{
+	// Decisions HandleDecision acts on.
+	constexpr ESFWDecision DoorDecisionTypes[] =
+	{
+		ESFWDecision::OpenDoor,
+		ESFWDecision::CloseDoor,
+		ESFWDecision::CloseAllDoorsInRoom,
+		ESFWDecision::LockDoor,
+		ESFWDecision::LockAllDoorsInRoom,
+		ESFWDecision::JamDoor,
+		ESFWDecision::DoorSlamScare,
+	};
 }
 
 void ASFW_DoorBase::BeginPlay()
@@ -86,10 +178,25 @@ void ASFW_DoorBase::BeginPlay()
 		State = StartState;
 		ApplyState();
 
-		for (TActorIterator<ASFW_AnomalyDecisionSystem> It(GetWorld()); It; ++It)
+		if (NavLink)
 		{
-			It->OnDecision.AddUObject(this, &ASFW_DoorBase::HandleDecision);
-			break;
+			NavLink->SetMoveReachedLink(this, &ASFW_DoorBase::OnNavLinkReached);
+			RefreshNavLinkState();
+		}
+
+		// Only door decisions aimed at this door's room are routed here.
+		USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this);
+		if (Registry && !RoomID.IsNone())
+		{
+			Registry->WhenDecisionSystemReady(FSFWOnDecisionSystemReady::FDelegate::CreateWeakLambda(this,
+				[this](ASFW_AnomalyDecisionSystem* Sys)
+				{
+					for (const ESFWDecision Type : DoorDecisionTypes)
+					{
+						Sys->SubscribeToDecision(RoomID, Type,
+							FSFWOnDecision::FDelegate::CreateUObject(this, &ASFW_DoorBase::HandleDecision));
+					}
+				}));
 		}
 	}
 
@@ -105,9 +212,12 @@ void ASFW_DoorBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	if (HasAuthority())
 	{
-		for (TActorIterator<ASFW_AnomalyDecisionSystem> It(GetWorld()); It; ++It)
+		if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
 		{
-			It->OnDecision.RemoveAll(this);
+			if (ASFW_AnomalyDecisionSystem* Sys = Registry->GetDecisionSystem())
+			{
+				Sys->UnsubscribeFromDecisions(this);
+			}
 		}
 	}
 	Super::EndPlay(EndPlayReason);
@@ -215,6 +325,7 @@ void ASFW_DoorBase::FinishMotion()
 	{
 		State = bToOpen ? EDoorState::Open : EDoorState::Closed;
 		ApplyState();
+		InvalidateCachedPaths();
 	}
 	else
 	{
@@ -255,6 +366,8 @@ void ASFW_DoorBase::LockDoor(float Duration)
 
 	const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.f;
 	LockEndTime = Now + FMath::Max(Duration, 0.f);
+	InvalidateCachedPaths();
+	RefreshNavLinkState();
 
 	// When locking, ensure we close the door.
 	State = EDoorState::Closing;
@@ -265,6 +378,66 @@ void ASFW_DoorBase::Unlock()
 {
 	if (!HasAuthority()) return;
 	LockEndTime = 0.f;
+	InvalidateCachedPaths();
+	RefreshNavLinkState();
+}
+
+void ASFW_DoorBase::RefreshNavLinkState()
+{
+	if (!HasAuthority() || !NavLink) return;
+
+	UWorld* W = GetWorld();
+	if (!W) return;
+
+	const bool bLocked = IsLocked();
+	NavLink->SetEnabled(!bLocked);
+
+	if (bLocked)
+	{
+		// Lock expiry has no event of its own
+		const float Remaining = LockEndTime - W->GetTimeSeconds();
+		W->GetTimerManager().SetTimer(Timer_LockExpired, this, &ASFW_DoorBase::RefreshNavLinkState,
+			FMath::Max(Remaining, 0.05f), false);
+		return;
+	}
+
+	W->GetTimerManager().ClearTimer(Timer_LockExpired);
+
+	if (LinkAgentsWaiting.Num() > 0)
+	{
+		OpenDoor();
+		for (const TWeakObjectPtr<UObject>& Agent : LinkAgentsWaiting)
+		{
+			if (UObject* PathComp = Agent.Get())
+			{
+				NavLink->ResumePathFollowing(PathComp);
+			}
+		}
+		LinkAgentsWaiting.Reset();
+	}
+}
+
+void ASFW_DoorBase::OnNavLinkReached(UNavLinkCustomComponent* Link, UObject* PathComp, const FVector& /*DestPoint*/)
+{
+	// Paths avoid a locked link, but an agent already on its way waits for the unlock
+	if (IsLocked())
+	{
+		LinkAgentsWaiting.AddUnique(PathComp);
+		return;
+	}
+
+	// The leaf ignores pawns while it swings, so the agent can carry on straight away
+	OpenDoor();
+	Link->ResumePathFollowing(PathComp);
+}
+
+void ASFW_DoorBase::InvalidateCachedPaths() const
+{
+	// Corridors through this doorway may no longer be the way the Shade should go
+	if (USFW_RoomPathCacheSubsystem* Paths = USFW_RoomPathCacheSubsystem::Get(this))
+	{
+		Paths->InvalidateNear(GetActorLocation(), USFW_RoomPathCacheSubsystem::DoorInvalidateRadius);
+	}
 }
 
 // === Player interaction support ===
@@ -14,9 +14,9 @@
 #include "Net/UnrealNetwork.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
-#include "EngineUtils.h"
 
 #include "Core/Game/SFW_GameState.h"
+#include "Core/AnomalySystems/SFW_EMFSourceSubsystem.h"
 
 ASFW_EMFDevice::ASFW_EMFDevice()
 {
@@ -298,34 +298,11 @@ void ASFW_EMFDevice::DoServerScanForEMF()
 	ACharacter* OwnerChar = Cast<ACharacter>(GetOwner());
 	const FVector Origin = OwnerChar ? OwnerChar->GetActorLocation() : GetActorLocation();
 
-	float StrongestSignal = 0.f;
-
-	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
-	{
-		AActor* Test = *It;
-		if (!IsValid(Test) || Test == this)
-		{
-			continue;
-		}
-
-		if (!Test->ActorHasTag(FName("EMF_Source")))
-		{
-			continue;
-		}
-
-		const float Dist = FVector::Dist(Origin, Test->GetActorLocation());
-		if (Dist > this->ScanRadius)
-		{
-			continue;
-		}
-
-		const float Normalized = FMath::Clamp((this->ScanRadius - Dist) / this->ScanRadius, 0.f, 1.f);
-
-		if (Normalized > StrongestSignal)
-		{
-			StrongestSignal = Normalized;
-		}
-	}
+	// Only the grid cells within ScanRadius are visited.
+	USFW_EMFSourceSubsystem* EMFSources = USFW_EMFSourceSubsystem::Get(this);
+	const float StrongestSignal = EMFSources
+		? EMFSources->QueryStrongestSignal(Origin, ScanRadius, this)
+		: 0.f;
 
 	int32 NewLevel = FMath::Clamp(FMath::RoundToInt(StrongestSignal * 4.f), 0, 4);
 
@@ -7,13 +7,14 @@
 #include "Components/PrimitiveComponent.h"
 
 #include "Engine/World.h"
-#include "EngineUtils.h"
 #include "Net/UnrealNetwork.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
 #include "DrawDebugHelpers.h"
 
 #include "Core/AnomalySystems/SFW_SigilActor.h"
+#include "Core/AnomalySystems/SFW_SigilSystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
 
 ASFW_UVLight::ASFW_UVLight()
 {
@@ -178,6 +179,12 @@ void ASFW_UVLight::ApplyLightState()
 	}
 }
 
+ASFW_SigilSystem* ASFW_UVLight::ResolveSigilSystem() const
+{
+	const USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this);
+	return Registry ? Registry->GetSigilSystem() : nullptr;
+}
+
 void ASFW_UVLight::ServerScanTick()
 {
 	if (!HasAuthority() || !bIsOn)
@@ -193,9 +200,6 @@ void ASFW_UVLight::ServerScanTick()
 	const FVector Start = Spot->GetComponentLocation();
 	const FVector Dir = Spot->GetForwardVector();
 
-	const float CosThresh = FMath::Cos(FMath::DegreesToRadians(ConeHalfAngleDeg));
-	const float RangeSq = RevealRange * RevealRange;
-
 #if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
 	if (bDebugDraw)
 	{
@@ -203,28 +207,17 @@ void ASFW_UVLight::ServerScanTick()
 	}
 #endif
 
-	for (TActorIterator<ASFW_SigilActor> It(GetWorld()); It; ++It)
+	ASFW_SigilSystem* SigilSystem = ResolveSigilSystem();
+	if (!SigilSystem)
 	{
-		ASFW_SigilActor* Sigil = *It;
-		if (!Sigil || !Sigil->IsActive())
-		{
-			continue;
-		}
-
-		const FVector To = Sigil->GetActorLocation() - Start;
-		const float   DistSq = To.SizeSquared();
-		if (DistSq > RangeSq)
-		{
-			continue;
-		}
+		return;
+	}
 
-		const FVector ToN = To.GetSafeNormal();
-		const float   Dot = FVector::DotProduct(Dir, ToN);
-		if (Dot < CosThresh)
-		{
-			continue;
-		}
+	TArray<ASFW_SigilActor*> Hits;
+	SigilSystem->QuerySigilsInCone(Start, Dir, RevealRange, ConeHalfAngleDeg, Hits);
 
+	for (ASFW_SigilActor* Sigil : Hits)
+	{
 		// Charge the sigil instead of instantly revealing it.
 		Sigil->NotifyUVHit(ScanInterval);
 
@@ -3,9 +3,13 @@
 #include "Core/AnomalySystems/SFW_AnomalyController.h"
 
 #include "Core/Game/SFW_GameState.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 #include "Core/Rooms/RoomVolume.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
 #include "Core/AnomalySystems/SFW_SigilSystem.h"
 #include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
 #include "Core/AI/SFW_ShadeCharacterBase.h"
 #include "Core/Actors/SFW_DoorBase.h"
 #include "Core/Lights/SFW_PowerLibrary.h"
@@ -33,19 +37,20 @@ void ASFW_AnomalyController::BeginPlay()
         return;
     }
 
-    // Hook into the decision system once on the server
-    if (UWorld* World = GetWorld())
+    // Hook into the decision system once on the server (now, or when it registers)
+    if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
     {
-        for (TActorIterator<ASFW_AnomalyDecisionSystem> It(World); It; ++It)
-        {
-            ASFW_AnomalyDecisionSystem* Sys = *It;
-            if (Sys)
+        Registry->WhenDecisionSystemReady(FSFWOnDecisionSystemReady::FDelegate::CreateWeakLambda(this,
+            [this](ASFW_AnomalyDecisionSystem* Sys)
             {
-                Sys->OnDecision.AddUObject(this, &ASFW_AnomalyController::HandleShadeDecision);
+                for (const ESFWDecision Type : { ESFWDecision::SpawnShade, ESFWDecision::ShadeRoam,
+                                                 ESFWDecision::ShadeHunt, ESFWDecision::ShadeAlert })
+                {
+                    Sys->SubscribeToDecision(NAME_None, Type,
+                        FSFWOnDecision::FDelegate::CreateUObject(this, &ASFW_AnomalyController::HandleShadeDecision));
+                }
                 UE_LOG(LogAnomalyController, Log, TEXT("BeginPlay: Bound to AnomalyDecisionSystem %s"), *GetNameSafe(Sys));
-                break;
-            }
-        }
+            }));
     }
 }
 
@@ -77,7 +82,7 @@ bool ASFW_AnomalyController::IsForbiddenRoom(ARoomVolume* R) const
 void ASFW_AnomalyController::PickAnomalyType()
 {
     // Example: random between Binder and Splitter.
-    const int32 Roll = FMath::RandRange(0, 1);
+    const int32 Roll = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::AnomalyController).RandRange(0, 1);
     ActiveAnomalyType = (Roll == 0)
         ? ESFWAnomalyType::Binder
         : ESFWAnomalyType::Splitter;
@@ -111,15 +116,17 @@ void ASFW_AnomalyController::PickRooms()
         return;
     }
 
+    FRandomStream& Rng = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::AnomalyController);
+
     // Pick Base from the pool
-    const int32 BaseIdx = FMath::RandRange(0, Pool.Num() - 1);
+    const int32 BaseIdx = Rng.RandRange(0, Pool.Num() - 1);
     BaseRoom = Pool[BaseIdx];
 
     // Rift = any other from the pool
     TArray<ARoomVolume*> RiftPool = Pool;
     RiftPool.RemoveAt(BaseIdx);
 
-    const int32 RiftIdx = FMath::RandRange(0, RiftPool.Num() - 1);
+    const int32 RiftIdx = Rng.RandRange(0, RiftPool.Num() - 1);
     RiftRoom = RiftPool[RiftIdx];
 
     UE_LOG(LogAnomalyController, Log,
@@ -132,6 +139,14 @@ void ASFW_AnomalyController::StartRound()
 {
     if (!HasAuthority()) return;
 
+    // 0) Seed the round streams first so the picks below replay from the seed.
+    //    GameMode::StartRound normally did this already; level-BP rounds haven't.
+    ASFW_GameState* G = GS();
+    if (G && !G->bRoundActive)
+    {
+        G->RoundSeed = USFW_RoundRandomSubsystem::ChooseRoundSeed();
+    }
+
     // 1) Decide anomaly archetype.
     PickAnomalyType();
 
@@ -139,13 +154,12 @@ void ASFW_AnomalyController::StartRound()
     PickRooms();
 
     // 3) Mark round state on GameState.
-    if (ASFW_GameState* G = GS())
+    if (G)
     {
         const float Now = GetWorld()->GetTimeSeconds();
 
         G->bRoundActive = true;
         G->RoundStartTime = Now;
-        G->RoundSeed = FMath::Rand();
         G->BaseRoom = BaseRoom;
         G->RiftRoom = RiftRoom;
         // G->ActiveAnomalyType = ActiveAnomalyType; // if you add later
@@ -154,27 +168,23 @@ void ASFW_AnomalyController::StartRound()
     // 4) Initialize sigil layout.
     if (RiftRoom)
     {
-        if (UWorld* W = GetWorld())
+        if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
         {
-            ASFW_SigilSystem* SigilSystem = nullptr;
-            for (TActorIterator<ASFW_SigilSystem> It(W); It; ++It)
+            if (!Registry->GetSigilSystem())
             {
-                SigilSystem = *It;
-                break;
-            }
-
-            if (SigilSystem)
-            {
-                SigilSystem->InitializeLayoutForRoom(RiftRoom->RoomId);
                 UE_LOG(LogAnomalyController, Log,
-                    TEXT("StartRound: Initialized sigil layout for RiftRoom=%s"),
-                    *GetNameSafe(RiftRoom));
-            }
-            else
-            {
-                UE_LOG(LogAnomalyController, Warning,
-                    TEXT("StartRound: No ASFW_SigilSystem found in world; sigil puzzle disabled."));
+                    TEXT("StartRound: No ASFW_SigilSystem registered yet; layout deferred until it begins play."));
             }
+
+            const FName RiftId = RiftRoom->RoomId;
+            Registry->WhenSigilSystemReady(FSFWOnSigilSystemReady::FDelegate::CreateWeakLambda(this,
+                [this, RiftId](ASFW_SigilSystem* SigilSystem)
+                {
+                    SigilSystem->InitializeLayoutForRoom(RiftId);
+                    UE_LOG(LogAnomalyController, Log,
+                        TEXT("StartRound: Initialized sigil layout for RiftRoom=%s"),
+                        *RiftId.ToString());
+                }));
         }
     }
 
@@ -274,17 +284,16 @@ void ASFW_AnomalyController::SpawnInitialShade()
             *SpawnLocation.ToString(),
             *Origin.ToString());
 
-        // Open all doors in BaseRoom so the Shade isn't trapped.
-        if (BaseRoom)
+        // Open the doors on BaseRoom's boundary so the Shade isn't trapped.
+        const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(this);
+        if (BaseRoom && RoomIndex)
         {
-            const FName BaseId = BaseRoom->RoomId;
+            TArray<ASFW_DoorBase*> BaseDoors;
+            RoomIndex->GetRoomGraph().GetBoundaryDoors(BaseRoom->RoomId, BaseDoors);
 
-            for (TActorIterator<ASFW_DoorBase> It(World); It; ++It)
+            for (ASFW_DoorBase* Door : BaseDoors)
             {
-                ASFW_DoorBase* Door = *It;
-                if (!Door) continue;
-
-                if (Door->GetRoomID() == BaseId && !Door->IsLocked())
+                if (!Door->IsLocked())
                 {
                     Door->OpenDoor();
                 }
@@ -354,26 +363,11 @@ void ASFW_AnomalyController::HandleShadeDecision(const FSFWDecisionPayload& P)
             return;
         }
 
-        UWorld* World = GetWorld();
-        if (!World) return;
+        const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(this);
+        if (!RoomIndex) return;
 
         // Find room that contains the target
-        ARoomVolume* TargetRoom = nullptr;
-        for (TActorIterator<ARoomVolume> It(World); It; ++It)
-        {
-            ARoomVolume* Vol = *It;
-            if (!Vol || Vol->RoomId.IsNone()) continue;
-
-            FVector Origin, Extent;
-            Vol->GetActorBounds(true, Origin, Extent);
-            const FBox Box(Origin - Extent, Origin + Extent);
-
-            if (Box.IsInside(TargetPawn->GetActorLocation()))
-            {
-                TargetRoom = Vol;
-                break;
-            }
-        }
+        ARoomVolume* TargetRoom = RoomIndex->FindRoomAtLocation(TargetPawn->GetActorLocation());
 
         if (!TargetRoom)
         {
@@ -383,18 +377,8 @@ void ASFW_AnomalyController::HandleShadeDecision(const FSFWDecisionPayload& P)
         }
 
         // Only scare if they’re alone in that room
-        TArray<AActor*> Over;
-        TargetRoom->GetOverlappingActors(Over, APawn::StaticClass());
-
-        int32 PlayerCount = 0;
-        for (AActor* A : Over)
-        {
-            APawn* Pn = Cast<APawn>(A);
-            if (Pn && Pn->IsPlayerControlled())
-            {
-                ++PlayerCount;
-            }
-        }
+        const USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this);
+        const int32 PlayerCount = Occupancy ? Occupancy->GetNumPlayersInRoom(TargetRoom->RoomId) : 0;
 
         if (PlayerCount != 1)
         {
@@ -1,61 +1,49 @@
 ﻿// SFW_AnomalyDecisionSystem.cpp
 
 #include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyPropRegistrySubsystem.h"
+#include "Core/AnomalySystems/SFW_CompiledDecisionTables.h"
 #include "Core/Components/SFW_AnomalyPropComponent.h"
 #include "Core/Lights/SFW_PowerLibrary.h"
 #include "Core/Game/SFW_GameState.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 
 #include "TimerManager.h"
-#include "EngineUtils.h"
-#include "UObject/UObjectIterator.h"
+#include "HAL/PlatformTime.h"
 #include "GameFramework/Pawn.h"
 #include "Core/Rooms/RoomVolume.h"
-#include "Core/Game/SFW_PlayerState.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
 #include "Core/AI/SFW_ShadeCharacterBase.h"   // <— NEW
 
-// ---- Player-only room occupancy (ignores SafeRoom and similar) ----
-static void GetOccupiedRooms(UWorld* World, TArray<FName>& Out)
+// ---- Helper: the active Shade in this world (server) ----
+static ASFW_ShadeCharacterBase* FindActiveShade(UWorld* World)
 {
-    Out.Reset();
-    if (!World) return;
-
-    TSet<FName> Unique;
-
-    for (TActorIterator<ARoomVolume> It(World); It; ++It)
-    {
-        ARoomVolume* Vol = *It;
-        if (!Vol || Vol->RoomId.IsNone()) continue;
-        if (Vol->bIsSafeRoom) continue; // do not target safe rooms
-
-        TArray<AActor*> Over;
-        Vol->GetOverlappingActors(Over, APawn::StaticClass());
-
-        for (AActor* A : Over)
-        {
-            if (APawn* P = Cast<APawn>(A))
-            {
-                if (P->IsPlayerControlled())
-                {
-                    Unique.Add(Vol->RoomId);
-                    break;
-                }
-            }
-        }
-    }
+    const USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(World);
+    return Registry ? Registry->GetActiveShade() : nullptr; // we currently only support one shade
+}
 
-    Out = Unique.Array();
+// ---- Helpers: room graph lookups (server) ----
+static const FSFWRoomGraph* GetRoomGraph(const UObject* WorldContextObject)
+{
+    const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(WorldContextObject);
+    return RoomIndex && RoomIndex->GetRoomGraph().IsValid() ? &RoomIndex->GetRoomGraph() : nullptr;
 }
 
-// ---- Helper: find the first active Shade in this world (server) ----
-static ASFW_ShadeCharacterBase* FindActiveShade(UWorld* World)
+static bool IsSafeRoomId(const UObject* WorldContextObject, FName RoomId)
 {
-    if (!World) return nullptr;
+    const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(WorldContextObject);
+    if (!RoomIndex) return false;
 
-    for (TActorIterator<ASFW_ShadeCharacterBase> It(World); It; ++It)
+    for (const ARoomVolume* Volume : RoomIndex->GetVolumesForRoomId(RoomId))
     {
-        return *It; // we currently only support one shade, so first is fine
+        if (Volume->bIsSafeRoom)
+        {
+            return true;
+        }
     }
-    return nullptr;
+    return false;
 }
 
 ASFW_AnomalyDecisionSystem::ASFW_AnomalyDecisionSystem()
@@ -68,131 +56,167 @@ void ASFW_AnomalyDecisionSystem::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Doors, lamps and the controller bind through the registry (on every machine).
+    if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+    {
+        Registry->RegisterDecisionSystem(this);
+    }
+
     if (HasAuthority())
     {
-        if (!DecisionsDT)
+        // Without compiled tables, read DecisionsDT once here rather than per pick
+        if (!HasCompiledTables())
         {
-            UE_LOG(LogTemp, Warning, TEXT("AnomalyDecisionSystem: DecisionsDT is null."));
+            if (!DecisionsDT)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("AnomalyDecisionSystem: no CompiledTables and DecisionsDT is null."));
+            }
+            else
+            {
+                USFW_CompiledDecisionTables::ReadDecisionRows(DecisionsDT, TableRows);
+                DecisionsDT->OnDataTableChanged().AddUObject(this, &ASFW_AnomalyDecisionSystem::HandleDecisionsTableChanged);
+            }
         }
 
-        RefreshBiasFromProfile();
+        // Occupancy changes can make a sleeping system able to act again
+        if (USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this))
+        {
+            Occupancy->OnOccupancyChanged.AddWeakLambda(this, [this](FName) { WakeDecisions(); });
+        }
 
-        GetWorldTimerManager().SetTimer(
-            TickHandle,
-            this,
-            &ASFW_AnomalyDecisionSystem::TickDecision,
-            IntervalSec,
-            true
-        );
+        AddAnomalyAgent(ActiveAnomalyType);
+        for (const ESFWAnomalyType AnomalyType : AdditionalAnomalyTypes)
+        {
+            AddAnomalyAgent(AnomalyType);
+        }
     }
 }
 
 void ASFW_AnomalyDecisionSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     GetWorldTimerManager().ClearTimer(TickHandle);
-    Super::EndPlay(EndPlayReason);
-}
+    GetWorldTimerManager().ClearTimer(ApplyHandle);
+    ScheduledWakeTime = TNumericLimits<double>::Max();
+    PendingCosmetic.Reset();
 
-void ASFW_AnomalyDecisionSystem::RefreshBiasFromProfile()
-{
-    CachedDoorBias = 1.f;
-    CachedLightBias = 1.f;
+    // Worker evaluations read the room graph; let them finish before the world goes away
+    for (FAnomalyAgent& Agent : Agents)
+    {
+        if (Agent.PendingEvaluation.IsValid())
+        {
+            Agent.PendingEvaluation.Wait();
+        }
+    }
+    Agents.Reset();
 
-    if (!AnomalyProfilesDT)
+    if (USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this))
     {
-        return;
+        Occupancy->OnOccupancyChanged.RemoveAll(this);
     }
 
-    for (const auto& Pair : AnomalyProfilesDT->GetRowMap())
+    if (DecisionsDT)
     {
-        if (FSFWAnomalyProfileRow* Row = reinterpret_cast<FSFWAnomalyProfileRow*>(Pair.Value))
-        {
-            if (Row->AnomalyType == ActiveAnomalyType)
-            {
-                CachedDoorBias = Row->DoorBias;
-                CachedLightBias = Row->LightBias;
-                return;
-            }
-        }
+        DecisionsDT->OnDataTableChanged().RemoveAll(this);
     }
+
+    if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+    {
+        Registry->UnregisterDecisionSystem(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
-void ASFW_AnomalyDecisionSystem::HandlePropPulse(const FSFWDecisionRow& R, FName RoomId)
+void ASFW_AnomalyDecisionSystem::RefreshBiasFromProfile(FAnomalyAgent& Agent) const
 {
-    UWorld* World = GetWorld();
-    if (!World || RoomId.IsNone())
+    FSFWAnomalyProfileView Profile;
+    if (HasCompiledTables())
     {
-        return;
+        Profile = CompiledTables->GetProfile(Agent.AnomalyType);
     }
-
-    // 1) Collect all room volumes that share this RoomId (base + Rift, etc.)
-    TArray<ARoomVolume*> RoomsForId;
-    for (TActorIterator<ARoomVolume> It(World); It; ++It)
+    else if (AnomalyProfilesDT)
     {
-        ARoomVolume* Vol = *It;
-        if (Vol && Vol->RoomId == RoomId)
+        TArray<FSFWAnomalyProfileView> Profiles;
+        USFW_CompiledDecisionTables::ReadProfiles(AnomalyProfilesDT, Profiles);
+        const int32 Index = static_cast<int32>(Agent.AnomalyType);
+        if (Profiles.IsValidIndex(Index))
         {
-            RoomsForId.Add(Vol);
+            Profile = Profiles[Index];
         }
     }
 
-    if (RoomsForId.Num() == 0)
+    Agent.DoorBias = Profile.DoorBias;
+    Agent.LightBias = Profile.LightBias;
+}
+
+void ASFW_AnomalyDecisionSystem::AddAnomalyAgent(ESFWAnomalyType AnomalyType)
+{
+    if (!HasAuthority() || !GetWorld() || AnomalyType == ESFWAnomalyType::None || FindAgent(AnomalyType))
     {
         return;
     }
 
-    // 2) Find all anomaly props whose owners are inside ANY of those volumes
-    TArray<USFW_AnomalyPropComponent*> Candidates;
-
-    for (TObjectIterator<USFW_AnomalyPropComponent> It; It; ++It)
+    if (!ensureMsgf(!bEvaluatingAgents, TEXT("AddAnomalyAgent called from a decision handler")))
     {
-        USFW_AnomalyPropComponent* Comp = *It;
-        if (!Comp) continue;
+        return;
+    }
 
-        AActor* PropActor = Comp->GetOwner();
-        if (!PropActor) continue;
+    FAnomalyAgent& Agent = Agents.AddDefaulted_GetRef();
+    Agent.AnomalyType = AnomalyType;
+    RefreshBiasFromProfile(Agent);
 
-        // Only consider actors in this world (ignore preview/editor worlds)
-        if (PropActor->GetWorld() != World) continue;
+    ScheduleAgentAt(Agent, GetWorld()->GetTimeSeconds() + IntervalSec);
+}
 
-        const FVector Loc = PropActor->GetActorLocation();
-        bool bInRoom = false;
+void ASFW_AnomalyDecisionSystem::RemoveAnomalyAgent(ESFWAnomalyType AnomalyType)
+{
+    if (AnomalyType == ActiveAnomalyType)
+    {
+        return;
+    }
 
-        for (ARoomVolume* Vol : RoomsForId)
-        {
-            if (!Vol) continue;
+    if (!ensureMsgf(!bEvaluatingAgents, TEXT("RemoveAnomalyAgent called from a decision handler")))
+    {
+        return;
+    }
 
-            FVector Origin, Extent;
-            Vol->GetActorBounds(true, Origin, Extent);
-            const FBox Box(Origin - Extent, Origin + Extent);
+    // Keep order: Agents[0] stays the primary, and tie-breaks stay stable
+    Agents.RemoveAll([AnomalyType](const FAnomalyAgent& Agent) { return Agent.AnomalyType == AnomalyType; });
+}
 
-            if (Box.IsInside(Loc))
-            {
-                bInRoom = true;
-                break;
-            }
-        }
+ASFW_AnomalyDecisionSystem::FAnomalyAgent* ASFW_AnomalyDecisionSystem::FindAgent(ESFWAnomalyType AnomalyType)
+{
+    return Agents.FindByPredicate([AnomalyType](const FAnomalyAgent& Agent) { return Agent.AnomalyType == AnomalyType; });
+}
 
-        if (bInRoom)
-        {
-            Candidates.Add(Comp);
-        }
-    }
+bool ASFW_AnomalyDecisionSystem::HasCompiledTables() const
+{
+    return CompiledTables && CompiledTables->IsCompiled();
+}
 
-    if (Candidates.Num() == 0)
+void ASFW_AnomalyDecisionSystem::HandlePropPulse(const FSFWDecisionRowView& R, FName RoomId)
+{
+    UWorld* World = GetWorld();
+    if (!World || RoomId.IsNone())
     {
         return;
     }
 
-    // 3) Pick one at random and apply the action
-    USFW_AnomalyPropComponent* Chosen =
-        Candidates[FMath::RandRange(0, Candidates.Num() - 1)];
+    // Pick straight from the room's prop bucket; cost is independent of total prop count
+    USFW_AnomalyPropRegistrySubsystem* PropRegistry = USFW_AnomalyPropRegistrySubsystem::Get(this);
+    if (!PropRegistry)
+    {
+        return;
+    }
 
-    if (!Chosen || !Chosen->GetOwner())
+    TArray<USFW_AnomalyPropComponent*> Picked;
+    if (PropRegistry->SamplePropsInRoom(RoomId, 1, Picked) == 0)
     {
         return;
     }
 
+    USFW_AnomalyPropComponent* Chosen = Picked[0];
+
     AActor* PropActor = Chosen->GetOwner();
 
     switch (R.Type)
@@ -214,89 +238,115 @@ void ASFW_AnomalyDecisionSystem::HandlePropPulse(const FSFWDecisionRow& R, FName
     }
 }
 
-bool ASFW_AnomalyDecisionSystem::IsReady(const FSFWDecisionRow& R) const
+float ASFW_AnomalyDecisionSystem::GetCooldownRemaining(ESFWDecision Type) const
+{
+    const UWorld* World = GetWorld();
+    return World ? static_cast<float>(GetCooldowns().GetRemaining(Type, World->GetTimeSeconds())) : 0.f;
+}
+
+double ASFW_AnomalyDecisionSystem::GetNextCooldownExpiry()
 {
     const double Now = GetWorld()->GetTimeSeconds();
-    if (const double* T = NextAllowedTime.Find(R.Type))
+
+    double Earliest = TNumericLimits<double>::Max();
+    for (FAnomalyAgent& Agent : Agents)
     {
-        return Now >= *T;
+        Earliest = FMath::Min(Earliest, Agent.Selector.GetCooldowns().GetNextExpiry(Now));
     }
-    return true;
+    return Earliest;
 }
 
-void ASFW_AnomalyDecisionSystem::StartCooldown(const FSFWDecisionRow& R)
+const FSFWDecisionCooldowns& ASFW_AnomalyDecisionSystem::GetCooldowns() const
 {
-    NextAllowedTime.FindOrAdd(R.Type) = GetWorld()->GetTimeSeconds() + R.CooldownSec;
+    static const FSFWDecisionCooldowns NoCooldowns;
+    const FAnomalyAgent* Agent = Agents.FindByPredicate(
+        [this](const FAnomalyAgent& A) { return A.AnomalyType == ActiveAnomalyType; });
+    return Agent ? Agent->Selector.GetCooldowns() : NoCooldowns;
+}
+
+bool ASFW_AnomalyDecisionSystem::EnsureSamplerCompiled(FAnomalyAgent& Agent)
+{
+    if (HasCompiledTables())
+    {
+        return Agent.Selector.Prepare(CompiledTables, CompiledTables->GetDecisionRows(), Agent.DoorBias, Agent.LightBias);
+    }
+    return Agent.Selector.Prepare(DecisionsDT, TableRows, Agent.DoorBias, Agent.LightBias);
 }
 
-const FSFWDecisionRow* ASFW_AnomalyDecisionSystem::PickWeighted(int32 Tier)
+void ASFW_AnomalyDecisionSystem::HandleDecisionsTableChanged()
 {
-    if (!DecisionsDT) return nullptr;
+    // Editor edits to the fallback table: re-read it and recompile on the next pick.
+    USFW_CompiledDecisionTables::ReadDecisionRows(DecisionsDT, TableRows);
+    for (FAnomalyAgent& Agent : Agents)
+    {
+        Agent.Selector.Invalidate();
+    }
+    WakeDecisions();
+}
 
-    TArray<FSFWDecisionRow*> Options;
-    for (const auto& Pair : DecisionsDT->GetRowMap())
+void ASFW_AnomalyDecisionSystem::WakeDecisions()
+{
+    if (HasAuthority() && GetWorld())
     {
-        if (FSFWDecisionRow* Row = reinterpret_cast<FSFWDecisionRow*>(Pair.Value))
+        for (FAnomalyAgent& Agent : Agents)
         {
-            if (Row->Tier == Tier && IsReady(*Row) && Row->Weight > 0.f)
-            {
-                Options.Add(Row);
-            }
+            ScheduleAgentAt(Agent, GetWorld()->GetTimeSeconds());
         }
     }
+}
 
-    if (Options.Num() == 0) return nullptr;
+void ASFW_AnomalyDecisionSystem::ScheduleAgentAt(FAnomalyAgent& Agent, double WakeTime)
+{
+    if (WakeTime >= TNumericLimits<double>::Max())
+    {
+        return;
+    }
 
-    auto GetBiasForDecision = [this](const FSFWDecisionRow* R) -> float
-        {
-            switch (R->Type)
-            {
-                // Light-related actions
-            case ESFWDecision::LampFlicker:
-            case ESFWDecision::BlackoutRoom:
-                return CachedLightBias;
+    // Never more often than IntervalSec after this agent's last decision.
+    WakeTime = FMath::Max3(WakeTime, GetWorld()->GetTimeSeconds(), Agent.LastDecisionTime + IntervalSec);
 
-                // Door-related actions
-            case ESFWDecision::OpenDoor:
-            case ESFWDecision::CloseDoor:
-            case ESFWDecision::LockDoor:
-            case ESFWDecision::JamDoor:
-            case ESFWDecision::KnockDoor:
-                return CachedDoorBias;
+    Agent.WakeTime = FMath::Min(Agent.WakeTime, WakeTime);
+    ScheduleDecisionAt(Agent.WakeTime);
+}
 
-            default:
-                return 1.f; // neutral
-            }
-        };
+void ASFW_AnomalyDecisionSystem::ScheduleDecisionAt(double WakeTime)
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    WakeTime = FMath::Max(WakeTime, Now);
 
-    // Compute total biased weight
-    float TotalW = 0.f;
-    for (const FSFWDecisionRow* R : Options)
+    // An earlier wake-up is already pending; it will reschedule as needed.
+    if (ScheduledWakeTime <= WakeTime)
     {
-        const float W = FMath::Max(0.f, R->Weight * GetBiasForDecision(R));
-        TotalW += W;
+        return;
     }
 
-    if (TotalW <= 0.f) return nullptr;
+    ScheduledWakeTime = WakeTime;
+    GetWorldTimerManager().SetTimer(
+        TickHandle,
+        this,
+        &ASFW_AnomalyDecisionSystem::TickDecision,
+        FMath::Max(static_cast<float>(WakeTime - Now), MinWakeDelaySec),
+        false
+    );
+}
 
-    float Pick = FMath::FRandRange(0.f, TotalW);
-    for (const FSFWDecisionRow* R : Options)
-    {
-        const float W = FMath::Max(0.f, R->Weight * GetBiasForDecision(R));
-        Pick -= W;
-        if (Pick <= 0.f)
-        {
-            return R;
-        }
-    }
+const FSFWDecisionRowView* ASFW_AnomalyDecisionSystem::PickWeighted(FAnomalyAgent& Agent, int32 Tier)
+{
+    if (!EnsureSamplerCompiled(Agent)) return nullptr;
 
-    return Options.Last();
+    return Agent.Selector.Pick(Tier, GetWorld()->GetTimeSeconds(),
+        USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Decisions));
 }
 
-void ASFW_AnomalyDecisionSystem::Dispatch(const FSFWDecisionRow& R, FName RoomId)
+void ASFW_AnomalyDecisionSystem::Dispatch(const FSFWDecisionRowView& R, FName RoomId, ESFWAnomalyType AnomalyType)
 {
     FSFWDecisionPayload P{ R.Type, RoomId, R.Magnitude, R.Duration, this };
 
+    if (const AGameStateBase* GS = GetWorld() ? GetWorld()->GetGameState() : nullptr)
+    {
+        P.StartTime = GS->GetServerWorldTimeSeconds();
+    }
+
     if (HasAuthority())
     {
         // DEBUG: log which decision actually fired
@@ -315,7 +365,15 @@ void ASFW_AnomalyDecisionSystem::Dispatch(const FSFWDecisionRow& R, FName RoomId
         switch (R.Type)
         {
         case ESFWDecision::LampFlicker:
-            USFW_PowerLibrary::FlickerRoom(this, RoomId, R.Duration);
+            if (bSynthesizeLampEffects)
+            {
+                // Lamps flicker from the payload on every machine (BroadcastToMulticastListeners)
+                P.Seed = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Lamps).RandRange(0, MAX_uint16);
+            }
+            else
+            {
+                USFW_PowerLibrary::FlickerRoom(this, RoomId, R.Duration);
+            }
             break;
 
         case ESFWDecision::BlackoutRoom:
@@ -327,7 +385,7 @@ void ASFW_AnomalyDecisionSystem::Dispatch(const FSFWDecisionRow& R, FName RoomId
         }
 
         // 2) Binder-specific EMF + prop + radio hooks
-        if (ActiveAnomalyType == ESFWAnomalyType::Binder)
+        if (AnomalyType == ESFWAnomalyType::Binder)
         {
             switch (R.Type)
             {
@@ -359,100 +417,339 @@ void ASFW_AnomalyDecisionSystem::Dispatch(const FSFWDecisionRow& R, FName RoomId
         }
     }
 
-    // Notify listeners (doors, BP, etc)
+    // Notify listeners: routed subscribers (doors, controller) first, then legacy / BP
+    if (HasAuthority())
+    {
+        BroadcastRoutes(ServerRoutes, P);
+    }
     OnDecision.Broadcast(P);
-    MulticastDecision(P);
+
+    if (bBatchCosmeticDecisions && HasAuthority() && IsCosmeticDecision(R.Type))
+    {
+        QueueCosmeticDecision(P);
+    }
+    else
+    {
+        MulticastDecision(P);
+    }
 }
 
-void ASFW_AnomalyDecisionSystem::MulticastDecision_Implementation(const FSFWDecisionPayload& Payload)
+bool ASFW_AnomalyDecisionSystem::IsCosmeticDecision(ESFWDecision Type)
+{
+    switch (Type)
+    {
+    case ESFWDecision::LampFlicker:
+    case ESFWDecision::KnockDoor:
+    case ESFWDecision::PropPulse:
+    case ESFWDecision::PropToss:
+    case ESFWDecision::SigilHint:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void ASFW_AnomalyDecisionSystem::QueueCosmeticDecision(const FSFWDecisionPayload& Payload)
+{
+    // Host listeners don't wait for the bundle (the multicast skips them on the server),
+    // but get the values the bundle will carry so flickers run the same length everywhere
+    FSFWDecisionPayload HostPayload = Payload;
+    HostPayload.Magnitude = FSFWDecisionBundle::RoundTrip(Payload.Magnitude);
+    HostPayload.Duration = FSFWDecisionBundle::RoundTrip(Payload.Duration);
+    BroadcastToMulticastListeners(HostPayload);
+
+    if (PendingCosmetic.IsFull())
+    {
+        FlushCosmeticDecisions();
+    }
+
+    if (PendingCosmetic.IsEmpty())
+    {
+        GetWorldTimerManager().SetTimerForNextTick(this, &ASFW_AnomalyDecisionSystem::FlushCosmeticDecisions);
+    }
+
+    PendingCosmetic.Add(Payload);
+}
+
+void ASFW_AnomalyDecisionSystem::FlushCosmeticDecisions()
 {
+    if (PendingCosmetic.IsEmpty())
+    {
+        return;
+    }
+
+    MulticastCosmeticDecisions(PendingCosmetic);
+    PendingCosmetic.Reset();
+}
+
+void ASFW_AnomalyDecisionSystem::BroadcastToMulticastListeners(const FSFWDecisionPayload& Payload)
+{
+    if (bSynthesizeLampEffects && Payload.Type == ESFWDecision::LampFlicker)
+    {
+        USFW_PowerLibrary::PlayFlickerRoomLocal(this, Payload.RoomId, Payload.StartTime, Payload.Duration, Payload.Seed);
+    }
+
+    BroadcastRoutes(MulticastRoutes, Payload);
     OnDecisionBP.Broadcast(Payload);
 }
 
-// local helper
-static int32 SanityTierToInt(ESanityTier T)
+void ASFW_AnomalyDecisionSystem::MulticastDecision_Implementation(const FSFWDecisionPayload& Payload)
 {
-    switch (T)
+    BroadcastToMulticastListeners(Payload);
+}
+
+void ASFW_AnomalyDecisionSystem::MulticastCosmeticDecisions_Implementation(const FSFWDecisionBundle& Bundle)
+{
+    if (HasAuthority())
     {
-    case ESanityTier::T1: return 1;
-    case ESanityTier::T2: return 2;
-    case ESanityTier::T3: return 3;
-    default:              return 1;
+        return;
+    }
+
+    TArray<FSFWDecisionPayload> Payloads;
+    Bundle.Unpack(this, Payloads);
+    for (const FSFWDecisionPayload& Payload : Payloads)
+    {
+        BroadcastToMulticastListeners(Payload);
     }
 }
 
-int32 ASFW_AnomalyDecisionSystem::GetRoomTier(FName RoomId) const
+FDelegateHandle ASFW_AnomalyDecisionSystem::SubscribeToDecision(FName RoomId, ESFWDecision Type, const FSFWOnDecision::FDelegate& Handler)
 {
-    int32 MaxTier = 1;
+    return ServerRoutes.FindOrAdd(FSFWDecisionRouteKey(RoomId, Type)).Add(Handler);
+}
 
-    for (TActorIterator<ARoomVolume> It(GetWorld()); It; ++It)
+FDelegateHandle ASFW_AnomalyDecisionSystem::SubscribeToDecisionMulticast(FName RoomId, ESFWDecision Type, const FSFWOnDecision::FDelegate& Handler)
+{
+    return MulticastRoutes.FindOrAdd(FSFWDecisionRouteKey(RoomId, Type)).Add(Handler);
+}
+
+void ASFW_AnomalyDecisionSystem::UnsubscribeFromDecisions(const void* UserObject)
+{
+    // Entries are left in place (possibly empty) so a broadcast in flight never sees the map rehash.
+    for (TPair<FSFWDecisionRouteKey, FSFWOnDecision>& Route : ServerRoutes)
+    {
+        Route.Value.RemoveAll(UserObject);
+    }
+    for (TPair<FSFWDecisionRouteKey, FSFWOnDecision>& Route : MulticastRoutes)
     {
-        ARoomVolume* Vol = *It;
-        if (!Vol || Vol->RoomId != RoomId) continue;
+        Route.Value.RemoveAll(UserObject);
+    }
+}
 
-        TArray<AActor*> Over;
-        Vol->GetOverlappingActors(Over, APawn::StaticClass());
+void ASFW_AnomalyDecisionSystem::BroadcastRoutes(const TMap<FSFWDecisionRouteKey, FSFWOnDecision>& Routes, const FSFWDecisionPayload& Payload)
+{
+    if (const FSFWOnDecision* InRoom = Routes.Find(FSFWDecisionRouteKey(Payload.RoomId, Payload.Type)))
+    {
+        InRoom->Broadcast(Payload);
+    }
 
-        for (AActor* A : Over)
+    if (!Payload.RoomId.IsNone())
+    {
+        if (const FSFWOnDecision* AnyRoom = Routes.Find(FSFWDecisionRouteKey(NAME_None, Payload.Type)))
         {
-            APawn* P = Cast<APawn>(A);
-            if (!P || !P->IsPlayerControlled()) continue;
-
-            if (ASFW_PlayerState* PS = P->GetPlayerState<ASFW_PlayerState>())
-            {
-                MaxTier = FMath::Max(MaxTier, SanityTierToInt(PS->GetSanityTier()));
-            }
+            AnyRoom->Broadcast(Payload);
         }
-        break;
     }
+}
 
-    return MaxTier;
+int32 ASFW_AnomalyDecisionSystem::GetRoomTier(FName RoomId) const
+{
+    const USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this);
+    return Occupancy ? Occupancy->GetRoomTier(RoomId) : 1;
 }
 
 void ASFW_AnomalyDecisionSystem::TickDecision()
 {
-    if (!HasAuthority() || !DecisionsDT) return;
+    ScheduledWakeTime = TNumericLimits<double>::Max();
+
+    if (!HasAuthority() || !GetWorld()) return;
+
+    const double Now = GetWorld()->GetTimeSeconds();
 
+    // Most overdue first: an agent cut off by the budget is first in line next frame.
+    // The millisecond slack absorbs timers firing a hair early.
+    TArray<int32, TInlineAllocator<8>> Due;
+    for (int32 i = 0; i < Agents.Num(); ++i)
+    {
+        if (Agents[i].WakeTime <= Now + 1e-3)
+        {
+            Due.Add(i);
+        }
+    }
+    Due.StableSort([this](int32 A, int32 B) { return Agents[A].WakeTime < Agents[B].WakeTime; });
+
+    const uint64 BudgetCycles = static_cast<uint64>(DecisionBudgetMicros / (FPlatformTime::GetSecondsPerCycle64() * 1e6));
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    bEvaluatingAgents = true;
+    int32 NumEvaluated = 0;
+    for (const int32 Index : Due)
+    {
+        if (NumEvaluated > 0 && FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+        {
+            break;
+        }
+
+        // Sleeps (no wake time) until an occupancy / Shade / table event when nothing can fire
+        FAnomalyAgent& Agent = Agents[Index];
+        Agent.WakeTime = TNumericLimits<double>::Max();
+        ScheduleAgentAt(Agent, TryDecide(Agent));
+        ++NumEvaluated;
+    }
+    bEvaluatingAgents = false;
+
+    if (NumEvaluated < Due.Num())
+    {
+        UE_LOG(LogTemp, Verbose,
+            TEXT("[DecisionSystem] Budget spent after %d of %d due agents; rest run next frame"),
+            NumEvaluated, Due.Num());
+
+        GetWorldTimerManager().ClearTimer(TickHandle);
+        ScheduledWakeTime = Now;
+        TickHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ASFW_AnomalyDecisionSystem::TickDecision);
+        return;
+    }
+
+    // Re-arm for agents that weren't due this time
+    double Earliest = TNumericLimits<double>::Max();
+    for (const FAnomalyAgent& Agent : Agents)
+    {
+        Earliest = FMath::Min(Earliest, Agent.WakeTime);
+    }
+    if (Earliest < TNumericLimits<double>::Max())
+    {
+        ScheduleDecisionAt(Earliest);
+    }
+}
+
+double ASFW_AnomalyDecisionSystem::TryDecide(FAnomalyAgent& Agent)
+{
+    constexpr double Sleep = TNumericLimits<double>::Max();
+
+    // Already being evaluated; ApplyAsyncResults reschedules it
+    if (Agent.PendingEvaluation.IsValid()) return Sleep;
+
+    if (!EnsureSamplerCompiled(Agent)) return Sleep;
+
+    FSFWDecisionInput Input;
+    BuildDecisionInput(Input);
+
+    FRandomStream& Rng = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Decisions);
+
+    if (!bEvaluateAsync)
+    {
+        return ApplyDecision(Agent, Agent.Selector.Evaluate(Input, Rng));
+    }
+
+    // The worker reads the compiled rows through a shared read-only view, with the
+    // cooldowns resolved here, and a seed drawn here so the outcome doesn't depend on
+    // thread timing. Any alias table it rebuilds is adopted in ApplyAsyncResults.
+    const int32 Seed = static_cast<int32>(Rng.GetUnsignedInt());
+    FSFWDecisionSelectorView View = Agent.Selector.MakeView(Input.Now);
+    Agent.PendingEvaluation = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Input = MoveTemp(Input), View = MoveTemp(View), Seed]()
+        {
+            FRandomStream TaskRng(Seed);
+            return FSFWDecisionSelector::Evaluate(View, Input, TaskRng);
+        });
+
+    if (!GetWorldTimerManager().TimerExists(ApplyHandle))
+    {
+        ApplyHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ASFW_AnomalyDecisionSystem::ApplyAsyncResults);
+    }
+    return Sleep;
+}
+
+void ASFW_AnomalyDecisionSystem::BuildDecisionInput(FSFWDecisionInput& OutInput)
+{
     UWorld* World = GetWorld();
-    if (!World) return;
+    const USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this);
 
-    FName TargetRoom = NAME_None;
+    OutInput.Now = World->GetTimeSeconds();
+    OutInput.Graph = GetRoomGraph(this);
+    OutInput.TargetHops = TargetHopsFromPlayers;
+    OutInput.IntervalSec = IntervalSec;
 
-    // 1) Prefer the Shade's current room as the "where" for decisions.
     if (ASFW_ShadeCharacterBase* Shade = FindActiveShade(World))
     {
-        const FName ShadeRoom = Shade->GetCurrentRoomId();
-        if (!ShadeRoom.IsNone())
+        OutInput.ShadeRoom = Shade->GetCurrentRoomId();
+        if (!OutInput.ShadeRoom.IsNone())
         {
-            TargetRoom = ShadeRoom;
+            OutInput.ShadeRoomTier = GetRoomTier(OutInput.ShadeRoom);
 
-            // Optional: debug log, can be Verbose if too spammy
             UE_LOG(LogTemp, Verbose,
                 TEXT("[DecisionSystem] TickDecision: Using Shade room '%s'"),
-                *TargetRoom.ToString());
+                *OutInput.ShadeRoom.ToString());
         }
     }
 
-    // 2) Fallback to player-occupied rooms if Shade has no known room yet
-    if (TargetRoom.IsNone())
+    if (Occupancy)
     {
-        TArray<FName> CandidateRooms;
-        GetOccupiedRooms(World, CandidateRooms);
-
-        UE_LOG(LogTemp, Warning,
-            TEXT("[DecisionSystem] TickDecision: Candidates=%d"),
-            CandidateRooms.Num());
+        for (const FName& RoomId : Occupancy->GetOccupiedRooms())
+        {
+            OutInput.OccupiedRooms.Emplace(RoomId, Occupancy->GetRoomTier(RoomId));
+        }
+    }
 
-        if (CandidateRooms.Num() == 0) return;
+    if (OutInput.Graph && !bSafeRoomIdsGathered)
+    {
+        bSafeRoomIdsGathered = true;
+        for (const FName& RoomId : OutInput.Graph->RoomIds)
+        {
+            if (IsSafeRoomId(this, RoomId))
+            {
+                SafeRoomIds.Add(RoomId);
+            }
+        }
+    }
+    OutInput.SafeRooms = SafeRoomIds;
+}
 
-        TargetRoom = CandidateRooms[FMath::RandRange(0, CandidateRooms.Num() - 1)];
+double ASFW_AnomalyDecisionSystem::ApplyDecision(FAnomalyAgent& Agent, const FSFWDecisionResult& Result)
+{
+    if (Result.Outcome != ESFWDecisionOutcome::Decided)
+    {
+        return Result.WakeTime;
     }
 
-    const int32 Tier = GetRoomTier(TargetRoom);
+    const double Now = GetWorld()->GetTimeSeconds();
+    Agent.Selector.Commit(Result.Row, Now);
+    Agent.LastDecisionTime = Now;
+    Dispatch(Result.Row, Result.RoomId, Agent.AnomalyType);
+
+    return Now + IntervalSec;
+}
+
+void ASFW_AnomalyDecisionSystem::ApplyAsyncResults()
+{
+    if (!HasAuthority() || !GetWorld()) return;
+
+    bool bStillRunning = false;
+
+    bEvaluatingAgents = true;
+    for (FAnomalyAgent& Agent : Agents)
+    {
+        if (!Agent.PendingEvaluation.IsValid())
+        {
+            continue;
+        }
+
+        if (!Agent.PendingEvaluation.IsCompleted())
+        {
+            bStillRunning = true;
+            continue;
+        }
+
+        FSFWDecisionResult Result = Agent.PendingEvaluation.GetResult();
+        Agent.PendingEvaluation = {};
+        Agent.Selector.AdoptRebuilt(Result);
+        ScheduleAgentAt(Agent, ApplyDecision(Agent, Result));
+    }
+    bEvaluatingAgents = false;
 
-    if (const FSFWDecisionRow* R = PickWeighted(Tier))
+    if (bStillRunning)
     {
-        StartCooldown(*R);
-        Dispatch(*R, TargetRoom);
+        ApplyHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ASFW_AnomalyDecisionSystem::ApplyAsyncResults);
     }
 }
@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AnomalyPropRegistrySubsystem.cpp
+
+#include "Core/AnomalySystems/SFW_AnomalyPropRegistrySubsystem.h"
+#include "Core/Components/SFW_AnomalyPropComponent.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+USFW_AnomalyPropRegistrySubsystem* USFW_AnomalyPropRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_AnomalyPropRegistrySubsystem>() : nullptr;
+}
+
+bool USFW_AnomalyPropRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_AnomalyPropRegistrySubsystem::Deinitialize()
+{
+	Props.Empty();
+	IndexByProp.Empty();
+	PropsByRoom.Empty();
+
+	Super::Deinitialize();
+}
+
+void USFW_AnomalyPropRegistrySubsystem::AddToRoom(int32 PropIndex, FName RoomId)
+{
+	FPropEntry& Entry = Props[PropIndex];
+	Entry.RoomId = RoomId;
+
+	if (RoomId.IsNone())
+	{
+		Entry.SlotInRoom = INDEX_NONE;
+		return;
+	}
+
+	Entry.SlotInRoom = PropsByRoom.FindOrAdd(RoomId).Add(PropIndex);
+}
+
+void USFW_AnomalyPropRegistrySubsystem::RemoveFromRoom(int32 PropIndex)
+{
+	FPropEntry& Entry = Props[PropIndex];
+	TArray<int32>* Bucket = Entry.RoomId.IsNone() ? nullptr : PropsByRoom.Find(Entry.RoomId);
+
+	if (Bucket && Bucket->IsValidIndex(Entry.SlotInRoom))
+	{
+		const int32 Slot = Entry.SlotInRoom;
+		Bucket->RemoveAtSwap(Slot, EAllowShrinking::No);
+
+		// The last entry moved into Slot; fix its back-reference.
+		if (Bucket->IsValidIndex(Slot))
+		{
+			Props[(*Bucket)[Slot]].SlotInRoom = Slot;
+		}
+
+		if (Bucket->Num() == 0)
+		{
+			PropsByRoom.Remove(Entry.RoomId);
+		}
+	}
+
+	Entry.RoomId = NAME_None;
+	Entry.SlotInRoom = INDEX_NONE;
+}
+
+void USFW_AnomalyPropRegistrySubsystem::RegisterProp(USFW_AnomalyPropComponent* Prop)
+{
+	if (!Prop || !Prop->GetOwner() || IndexByProp.Contains(Prop))
+	{
+		return;
+	}
+
+	FPropEntry Entry;
+	Entry.Prop = Prop;
+
+	const int32 Index = Props.Add(Entry);
+	IndexByProp.Add(Prop, Index);
+
+	const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(this);
+	AddToRoom(Index, RoomIndex ? RoomIndex->FindRoomIdAtLocation(Prop->GetOwner()->GetActorLocation()) : NAME_None);
+}
+
+void USFW_AnomalyPropRegistrySubsystem::UnregisterProp(USFW_AnomalyPropComponent* Prop)
+{
+	int32 Index = INDEX_NONE;
+	if (!IndexByProp.RemoveAndCopyValue(Prop, Index))
+	{
+		return;
+	}
+
+	RemoveFromRoom(Index);
+	Props.RemoveAt(Index);
+}
+
+void USFW_AnomalyPropRegistrySubsystem::UpdatePropRoom(USFW_AnomalyPropComponent* Prop)
+{
+	const int32* Index = IndexByProp.Find(Prop);
+	if (!Index || !Prop->GetOwner())
+	{
+		return;
+	}
+
+	const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(this);
+	const FName NewRoom = RoomIndex ? RoomIndex->FindRoomIdAtLocation(Prop->GetOwner()->GetActorLocation()) : NAME_None;
+
+	if (Props[*Index].RoomId != NewRoom)
+	{
+		RemoveFromRoom(*Index);
+		AddToRoom(*Index, NewRoom);
+	}
+}
+
+FName USFW_AnomalyPropRegistrySubsystem::GetPropRoom(const USFW_AnomalyPropComponent* Prop) const
+{
+	const int32* Index = IndexByProp.Find(Prop);
+	return Index ? Props[*Index].RoomId : NAME_None;
+}
+
+int32 USFW_AnomalyPropRegistrySubsystem::GetNumPropsInRoom(FName RoomId) const
+{
+	const TArray<int32>* Bucket = PropsByRoom.Find(RoomId);
+	return Bucket ? Bucket->Num() : 0;
+}
+
+int32 USFW_AnomalyPropRegistrySubsystem::SamplePropsInRoom(FName RoomId, int32 Count, TArray<USFW_AnomalyPropComponent*>& OutProps)
+{
+	TArray<int32>* Bucket = PropsByRoom.Find(RoomId);
+	if (!Bucket || Count <= 0)
+	{
+		return 0;
+	}
+
+	FRandomStream& Rng = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Props);
+
+	int32 Added = 0;
+	int32 Next = 0;
+	while (Added < Count && Next < Bucket->Num())
+	{
+		// Swap a random not-yet-picked entry into position Next.
+		const int32 Pick = Rng.RandRange(Next, Bucket->Num() - 1);
+		if (Pick != Next)
+		{
+			Bucket->Swap(Next, Pick);
+			Props[(*Bucket)[Next]].SlotInRoom = Next;
+			Props[(*Bucket)[Pick]].SlotInRoom = Pick;
+		}
+
+		USFW_AnomalyPropComponent* Prop = Props[(*Bucket)[Next]].Prop.Get();
+		if (Prop && Prop->GetOwner())
+		{
+			OutProps.Add(Prop);
+			++Added;
+		}
+		++Next;
+	}
+
+	return Added;
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AnomalyRegistrySubsystem.cpp
+
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyDecisionSystem.h"
+#include "Core/AnomalySystems/SFW_SigilSystem.h"
+#include "Core/AI/SFW_ShadeCharacterBase.h"
+
+#include "Engine/World.h"
+
+namespace
+{
+	// Register Provider into Slot and flush the one-shot waiters.
+	template <typename T, typename DelegateType>
+	void RegisterProvider(TWeakObjectPtr<T>& Slot, T* Provider, DelegateType& Pending)
+	{
+		if (!Provider)
+		{
+			return;
+		}
+
+		if (Slot.IsValid() && Slot.Get() != Provider)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[AnomalyRegistry] Replacing %s with %s"),
+				*GetNameSafe(Slot.Get()), *GetNameSafe(Provider));
+		}
+		Slot = Provider;
+
+		// Move out first so callbacks may queue new waiters safely.
+		DelegateType Waiters = MoveTemp(Pending);
+		Pending.Clear();
+		Waiters.Broadcast(Provider);
+	}
+
+	template <typename T, typename DelegateType>
+	void WhenReady(const TWeakObjectPtr<T>& Slot, DelegateType& Pending, typename DelegateType::FDelegate&& Callback)
+	{
+		if (T* Provider = Slot.Get())
+		{
+			Callback.ExecuteIfBound(Provider);
+			return;
+		}
+		Pending.Add(MoveTemp(Callback));
+	}
+}
+
+USFW_AnomalyRegistrySubsystem* USFW_AnomalyRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_AnomalyRegistrySubsystem>() : nullptr;
+}
+
+bool USFW_AnomalyRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ---- Decision system ----
+
+void USFW_AnomalyRegistrySubsystem::RegisterDecisionSystem(ASFW_AnomalyDecisionSystem* System)
+{
+	RegisterProvider(DecisionSystem, System, PendingDecisionSystem);
+}
+
+void USFW_AnomalyRegistrySubsystem::UnregisterDecisionSystem(ASFW_AnomalyDecisionSystem* System)
+{
+	if (DecisionSystem.Get() == System)
+	{
+		DecisionSystem.Reset();
+	}
+}
+
+void USFW_AnomalyRegistrySubsystem::WhenDecisionSystemReady(FSFWOnDecisionSystemReady::FDelegate&& Callback)
+{
+	WhenReady(DecisionSystem, PendingDecisionSystem, MoveTemp(Callback));
+}
+
+// ---- Sigil system ----
+
+void USFW_AnomalyRegistrySubsystem::RegisterSigilSystem(ASFW_SigilSystem* System)
+{
+	RegisterProvider(SigilSystem, System, PendingSigilSystem);
+}
+
+void USFW_AnomalyRegistrySubsystem::UnregisterSigilSystem(ASFW_SigilSystem* System)
+{
+	if (SigilSystem.Get() == System)
+	{
+		SigilSystem.Reset();
+	}
+}
+
+void USFW_AnomalyRegistrySubsystem::WhenSigilSystemReady(FSFWOnSigilSystemReady::FDelegate&& Callback)
+{
+	WhenReady(SigilSystem, PendingSigilSystem, MoveTemp(Callback));
+}
+
+// ---- Shade ----
+
+void USFW_AnomalyRegistrySubsystem::RegisterShade(ASFW_ShadeCharacterBase* Shade)
+{
+	RegisterProvider(ActiveShade, Shade, PendingShade);
+}
+
+void USFW_AnomalyRegistrySubsystem::UnregisterShade(ASFW_ShadeCharacterBase* Shade)
+{
+	if (ActiveShade.Get() == Shade)
+	{
+		ActiveShade.Reset();
+	}
+}
+
+void USFW_AnomalyRegistrySubsystem::WhenShadeReady(FSFWOnShadeReady::FDelegate&& Callback)
+{
+	WhenReady(ActiveShade, PendingShade, MoveTemp(Callback));
+}
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_CompiledDecisionTables.cpp
+
+#include "Core/AnomalySystems/SFW_CompiledDecisionTables.h"
+
+#include "Algo/StableSort.h"
+#include "Engine/DataTable.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/ObjectSaveContext.h"
+
+static_assert(std::is_trivially_copyable_v<FSFWDecisionRowView>, "FSFWDecisionRowView must stay POD");
+static_assert(std::is_trivially_copyable_v<FSFWAnomalyProfileView>, "FSFWAnomalyProfileView must stay POD");
+
+void USFW_CompiledDecisionTables::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// The blob holds no object references
+	if (Ar.IsObjectReferenceCollector())
+	{
+		return;
+	}
+
+	int32 Version = FormatVersion;
+	TArray<uint8> Blob;
+
+	if (Ar.IsSaving())
+	{
+		if (bCompiled)
+		{
+			FMemoryWriter Writer(Blob);
+			Writer << DecisionRows;
+			Writer << Profiles;
+		}
+		else
+		{
+			Version = INDEX_NONE;
+		}
+	}
+
+	Ar << Version;
+	Ar << Blob;
+
+	if (Ar.IsLoading())
+	{
+		DecisionRows.Reset();
+		Profiles.Reset();
+		bCompiled = false;
+
+		if (Version == FormatVersion)
+		{
+			FMemoryReader Reader(Blob);
+			Reader << DecisionRows;
+			Reader << Profiles;
+			bCompiled = !Reader.IsError() && Profiles.Num() == NumAnomalyTypes;
+		}
+		else if (Version != INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[DecisionTables] %s was compiled with format %d (current %d); recompile it."),
+				*GetName(), Version, FormatVersion);
+		}
+
+		if (!bCompiled)
+		{
+			DecisionRows.Reset();
+			Profiles.Reset();
+		}
+	}
+}
+
+#if WITH_EDITOR
+void USFW_CompiledDecisionTables::Compile()
+{
+	Modify();
+
+	ReadDecisionRows(DecisionsSource, DecisionRows);
+	ReadProfiles(ProfilesSource, Profiles);
+	bCompiled = true;
+
+	UE_LOG(LogTemp, Display, TEXT("[DecisionTables] %s: compiled %d decision rows from %s, profiles from %s."),
+		*GetName(), DecisionRows.Num(),
+		DecisionsSource ? *DecisionsSource->GetName() : TEXT("<none>"),
+		ProfilesSource ? *ProfilesSource->GetName() : TEXT("<none>"));
+}
+
+void USFW_CompiledDecisionTables::PreSave(FObjectPreSaveContext SaveContext)
+{
+	// Never ship stale rows: saving always reflects the current source tables
+	if (!IsTemplate() && (DecisionsSource || ProfilesSource))
+	{
+		ReadDecisionRows(DecisionsSource, DecisionRows);
+		ReadProfiles(ProfilesSource, Profiles);
+		bCompiled = true;
+	}
+
+	Super::PreSave(SaveContext);
+}
+#endif
+
+const FSFWAnomalyProfileView& USFW_CompiledDecisionTables::GetProfile(ESFWAnomalyType AnomalyType) const
+{
+	static const FSFWAnomalyProfileView Neutral;
+	const int32 Index = static_cast<int32>(AnomalyType);
+	return Profiles.IsValidIndex(Index) ? Profiles[Index] : Neutral;
+}
+
+void USFW_CompiledDecisionTables::ReadDecisionRows(const UDataTable* Table, TArray<FSFWDecisionRowView>& OutRows)
+{
+	OutRows.Reset();
+
+	if (!Table || !Table->GetRowStruct() || !Table->GetRowStruct()->IsChildOf(FSFWDecisionRow::StaticStruct()))
+	{
+		return;
+	}
+
+	for (const auto& Pair : Table->GetRowMap())
+	{
+		const FSFWDecisionRow* Row = reinterpret_cast<const FSFWDecisionRow*>(Pair.Value);
+		if (!Row || Row->Weight <= 0.f)
+		{
+			continue;
+		}
+
+		FSFWDecisionRowView& View = OutRows.AddDefaulted_GetRef();
+		View.Tier = Row->Tier;
+		View.Type = Row->Type;
+		View.Weight = Row->Weight;
+		View.CooldownSec = Row->CooldownSec;
+		View.Magnitude = Row->Magnitude;
+		View.Duration = Row->Duration;
+	}
+
+	// Stable, so rows sharing tier and type keep table order
+	Algo::StableSortBy(OutRows, [](const FSFWDecisionRowView& Row)
+	{
+		return TPair<int32, uint8>(Row.Tier, static_cast<uint8>(Row.Type));
+	});
+}
+
+void USFW_CompiledDecisionTables::ReadProfiles(const UDataTable* Table, TArray<FSFWAnomalyProfileView>& OutProfiles)
+{
+	OutProfiles.Reset();
+	OutProfiles.SetNum(NumAnomalyTypes);
+
+	if (!Table || !Table->GetRowStruct() || !Table->GetRowStruct()->IsChildOf(FSFWAnomalyProfileRow::StaticStruct()))
+	{
+		return;
+	}
+
+	TBitArray<> bSeen(false, NumAnomalyTypes);
+	for (const auto& Pair : Table->GetRowMap())
+	{
+		const FSFWAnomalyProfileRow* Row = reinterpret_cast<const FSFWAnomalyProfileRow*>(Pair.Value);
+		const int32 Index = Row ? static_cast<int32>(Row->AnomalyType) : INDEX_NONE;
+		if (!OutProfiles.IsValidIndex(Index) || bSeen[Index])
+		{
+			continue;
+		}
+
+		bSeen[Index] = true;
+		OutProfiles[Index].DoorBias = Row->DoorBias;
+		OutProfiles[Index].LightBias = Row->LightBias;
+	}
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionCooldowns.cpp
+
+#include "Core/AnomalySystems/SFW_DecisionCooldowns.h"
+
+void FSFWDecisionCooldowns::Start(ESFWDecision Type, double ReadyAt)
+{
+	ReadyTime[Index(Type)] = ReadyAt;
+	Cooling |= FSFWDecisionSampler::TypeBit(Type);
+	Heap.HeapPush(FExpiry{ ReadyAt, Type });
+}
+
+void FSFWDecisionCooldowns::Reset()
+{
+	for (double& T : ReadyTime)
+	{
+		T = 0.0;
+	}
+	Heap.Reset();
+	Cooling = 0;
+}
+
+void FSFWDecisionCooldowns::PopExpired(double Now)
+{
+	while (Heap.Num() > 0)
+	{
+		const FExpiry& Top = Heap.HeapTop();
+		const bool bStale = ReadyTime[Index(Top.Type)] != Top.ReadyAt;
+		if (!bStale && Now < Top.ReadyAt)
+		{
+			break;
+		}
+
+		if (!bStale)
+		{
+			Cooling &= ~FSFWDecisionSampler::TypeBit(Top.Type);
+		}
+
+		FExpiry Popped;
+		Heap.HeapPop(Popped, EAllowShrinking::No);
+	}
+}
+
+FSFWDecisionSampler::FTypeMask FSFWDecisionCooldowns::GetCoolingTypes(double Now)
+{
+	PopExpired(Now);
+	return Cooling;
+}
+
+double FSFWDecisionCooldowns::GetNextExpiry(double Now)
+{
+	PopExpired(Now);
+	return Heap.Num() > 0 ? Heap.HeapTop().ReadyAt : TNumericLimits<double>::Max();
+}
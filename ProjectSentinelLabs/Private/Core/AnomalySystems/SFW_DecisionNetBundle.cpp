@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionNetBundle.cpp
+
+#include "Core/AnomalySystems/SFW_DecisionNetBundle.h"
+
+void FSFWDecisionBundle::Reset()
+{
+	StartTime = 0.0;
+	Rooms.Reset();
+	Entries.Reset();
+}
+
+uint16 FSFWDecisionBundle::Quantize(float Value)
+{
+	return static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Value * 100.f), 0, static_cast<int32>(MAX_uint16)));
+}
+
+void FSFWDecisionBundle::Add(const FSFWDecisionPayload& Payload)
+{
+	check(!IsFull());
+
+	if (IsEmpty())
+	{
+		StartTime = Payload.StartTime;
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Type = static_cast<uint8>(Payload.Type);
+	Entry.RoomSlot = static_cast<uint8>(Rooms.AddUnique(Payload.RoomId));
+	Entry.Magnitude = Quantize(Payload.Magnitude);
+	Entry.Duration = Quantize(Payload.Duration);
+	Entry.Seed = static_cast<uint16>(Payload.Seed);
+}
+
+void FSFWDecisionBundle::Unpack(AActor* Instigator, TArray<FSFWDecisionPayload>& OutPayloads) const
+{
+	OutPayloads.Reserve(OutPayloads.Num() + Entries.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		// Network input: never turn an unknown byte into an ESFWDecision
+		if (Entry.Type > static_cast<uint8>(ESFWDecision::ShadeAlert))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[DecisionBundle] Dropping entry with unknown decision type %u."), Entry.Type);
+			continue;
+		}
+
+		FSFWDecisionPayload& Payload = OutPayloads.AddDefaulted_GetRef();
+		Payload.Type = static_cast<ESFWDecision>(Entry.Type);
+		Payload.RoomId = Rooms.IsValidIndex(Entry.RoomSlot) ? Rooms[Entry.RoomSlot] : NAME_None;
+		Payload.Magnitude = Dequantize(Entry.Magnitude);
+		Payload.Duration = Dequantize(Entry.Duration);
+		Payload.StartTime = StartTime;
+		Payload.Seed = Entry.Seed;
+		Payload.Instigator = Instigator;
+	}
+}
+
+bool FSFWDecisionBundle::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 NumRooms = static_cast<uint8>(Rooms.Num());
+	uint8 NumEntries = static_cast<uint8>(Entries.Num());
+	Ar << NumRooms;
+	Ar << NumEntries;
+	Ar << StartTime;
+
+	if (Ar.IsLoading())
+	{
+		Rooms.SetNum(NumRooms);
+		Entries.SetNum(NumEntries);
+	}
+
+	for (FName& Room : Rooms)
+	{
+		Ar << Room;
+	}
+
+	for (FEntry& Entry : Entries)
+	{
+		Ar << Entry.Type;
+		Ar << Entry.RoomSlot;
+		Ar << Entry.Magnitude;
+		Ar << Entry.Duration;
+		Ar << Entry.Seed;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
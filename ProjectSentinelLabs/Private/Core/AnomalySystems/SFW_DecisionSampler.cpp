@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSampler.cpp
+
+#include "Core/AnomalySystems/SFW_DecisionSampler.h"
+
+static_assert(static_cast<uint8>(ESFWDecision::ShadeAlert) < 64, "ESFWDecision no longer fits FSFWDecisionSampler::FTypeMask");
+
+float FSFWDecisionSampler::GetBias(ESFWDecision Type, float DoorBias, float LightBias)
+{
+	switch (Type)
+	{
+		// Light-related actions
+	case ESFWDecision::LampFlicker:
+	case ESFWDecision::BlackoutRoom:
+		return LightBias;
+
+		// Door-related actions
+	case ESFWDecision::OpenDoor:
+	case ESFWDecision::CloseDoor:
+	case ESFWDecision::LockDoor:
+	case ESFWDecision::JamDoor:
+	case ESFWDecision::KnockDoor:
+		return DoorBias;
+
+	default:
+		return 1.f; // neutral
+	}
+}
+
+void FSFWDecisionSampler::Compile(const UObject* Source, TConstArrayView<FSFWDecisionRowView> Rows, float DoorBias, float LightBias)
+{
+	Reset();
+
+	CompiledSource = Source;
+	CompiledDoorBias = DoorBias;
+	CompiledLightBias = LightBias;
+
+	for (const FSFWDecisionRowView& Row : Rows)
+	{
+		if (Row.Weight <= 0.f)
+		{
+			continue;
+		}
+
+		const float W = FMath::Max(0.f, Row.Weight * GetBias(Row.Type, DoorBias, LightBias));
+		if (W <= 0.f)
+		{
+			continue;
+		}
+
+		FTierTable& TierTable = Tiers.FindOrAdd(Row.Tier);
+		TierTable.Rows.Add(Row);
+		TierTable.Weights.Add(W);
+		TierTable.Types |= TypeBit(Row.Type);
+		AllTypes |= TypeBit(Row.Type);
+	}
+}
+
+void FSFWDecisionSampler::Reset()
+{
+	Tiers.Reset();
+	AllTypes = 0;
+	CompiledSource = nullptr;
+	CompiledDoorBias = 1.f;
+	CompiledLightBias = 1.f;
+}
+
+void FSFWDecisionSampler::FTierTable::BuildAlias(FTypeMask Mask, FAliasTable& Out) const
+{
+	Out.BuiltMask = Mask;
+	Out.bBuilt = true;
+
+	TArray<int32>& Eligible = Out.Eligible;
+	TArray<float>& Prob = Out.Prob;
+	TArray<int32>& Alias = Out.Alias;
+
+	Eligible.Reset();
+	float Total = 0.f;
+	for (int32 i = 0; i < Rows.Num(); ++i)
+	{
+		if (Mask & TypeBit(Rows[i].Type))
+		{
+			Eligible.Add(i);
+			Total += Weights[i];
+		}
+	}
+
+	const int32 Num = Eligible.Num();
+	Prob.SetNumUninitialized(Num);
+	Alias.SetNumUninitialized(Num);
+	if (Num == 0 || Total <= 0.f)
+	{
+		Eligible.Reset();
+		return;
+	}
+
+	// Vose: scale weights so the mean is 1, then pair each under-full slot with an over-full one.
+	TArray<float, TInlineAllocator<32>> Scaled;
+	TArray<int32, TInlineAllocator<32>> Small;
+	TArray<int32, TInlineAllocator<32>> Large;
+	Scaled.SetNumUninitialized(Num);
+	for (int32 k = 0; k < Num; ++k)
+	{
+		Scaled[k] = Weights[Eligible[k]] * Num / Total;
+		(Scaled[k] < 1.f ? Small : Large).Add(k);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		Prob[Less] = Scaled[Less];
+		Alias[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.f;
+		(Scaled[More] < 1.f ? Small : Large).Add(More);
+	}
+
+	// Whatever is left is 1 up to float error.
+	for (const int32 k : Large)
+	{
+		Prob[k] = 1.f;
+		Alias[k] = k;
+	}
+	for (const int32 k : Small)
+	{
+		Prob[k] = 1.f;
+		Alias[k] = k;
+	}
+}
+
+const FSFWDecisionRowView* FSFWDecisionSampler::FTierTable::DrawFrom(const FAliasTable& Table, FRandomStream& Rng) const
+{
+	const int32 Num = Table.Eligible.Num();
+	if (Num == 0)
+	{
+		return nullptr;
+	}
+
+	const int32 Slot = Rng.RandRange(0, Num - 1);
+	const int32 Pick = (Rng.FRand() < Table.Prob[Slot]) ? Slot : Table.Alias[Slot];
+	return &Rows[Table.Eligible[Pick]];
+}
+
+const FSFWDecisionRowView* FSFWDecisionSampler::DrawShared(int32 Tier, FTypeMask AllowedTypes, FRandomStream& Rng, FAliasTable& OutRebuilt) const
+{
+	const FTierTable* TierTable = Tiers.Find(Tier);
+	if (!TierTable)
+	{
+		return nullptr;
+	}
+
+	// Only the bits of types this tier actually uses matter for the cached table.
+	const FTypeMask Mask = AllowedTypes & TierTable->Types;
+	if (TierTable->Cached.bBuilt && TierTable->Cached.BuiltMask == Mask)
+	{
+		return TierTable->DrawFrom(TierTable->Cached, Rng);
+	}
+
+	TierTable->BuildAlias(Mask, OutRebuilt);
+	return TierTable->DrawFrom(OutRebuilt, Rng);
+}
+
+void FSFWDecisionSampler::AdoptAlias(int32 Tier, FAliasTable&& Table)
+{
+	FTierTable* TierTable = Tiers.Find(Tier);
+	if (TierTable && Table.bBuilt && (Table.BuiltMask & ~TierTable->Types) == 0)
+	{
+		TierTable->Cached = MoveTemp(Table);
+	}
+}
+
+const FSFWDecisionRowView* FSFWDecisionSampler::Draw(int32 Tier, FTypeMask AllowedTypes, FRandomStream& Rng)
+{
+	FAliasTable Rebuilt;
+	const FSFWDecisionRowView* Row = DrawShared(Tier, AllowedTypes, Rng, Rebuilt);
+	if (Rebuilt.bBuilt)
+	{
+		AdoptAlias(Tier, MoveTemp(Rebuilt));
+	}
+	return Row;
+}
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSelector.cpp
+
+#include "Core/AnomalySystems/SFW_DecisionSelector.h"
+#include "Core/Rooms/SFW_RoomGraph.h"
+
+bool FSFWDecisionSelector::Prepare(const UObject* Source, TConstArrayView<FSFWDecisionRowView> Rows, float DoorBias, float LightBias)
+{
+	if (!Source)
+	{
+		return false;
+	}
+
+	if (!Sampler->IsCompiledFor(Source, DoorBias, LightBias))
+	{
+		// A fresh object: views still held by workers keep reading the old one
+		TSharedRef<FSFWDecisionSampler> Compiled = MakeShared<FSFWDecisionSampler>();
+		Compiled->Compile(Source, Rows, DoorBias, LightBias);
+		Sampler = Compiled;
+	}
+	return true;
+}
+
+FSFWDecisionSampler& FSFWDecisionSelector::MutableSampler()
+{
+	if (!Sampler.IsUnique())
+	{
+		Sampler = MakeShared<FSFWDecisionSampler>(*Sampler);
+	}
+	return *Sampler;
+}
+
+FSFWDecisionSelectorView FSFWDecisionSelector::MakeView(double Now)
+{
+	FSFWDecisionSelectorView View{ Sampler };
+	View.CoolingTypes = Cooldowns.GetCoolingTypes(Now);
+	View.NextExpiry = Cooldowns.GetNextExpiry(Now);
+	return View;
+}
+
+void FSFWDecisionSelector::AdoptRebuilt(FSFWDecisionResult& Result)
+{
+	const bool bCurrent = Result.SamplerUsed.Get() == &Sampler.Get();
+	Result.SamplerUsed.Reset();
+
+	if (bCurrent && Result.RebuiltAlias.bBuilt)
+	{
+		MutableSampler().AdoptAlias(Result.RebuiltTier, MoveTemp(Result.RebuiltAlias));
+	}
+	Result.RebuiltTier = INDEX_NONE;
+}
+
+FSFWDecisionResult FSFWDecisionSelector::Evaluate(const FSFWDecisionInput& Input, FRandomStream& Rng)
+{
+	FSFWDecisionResult Result = Evaluate(MakeView(Input.Now), Input, Rng);
+	AdoptRebuilt(Result);
+	return Result;
+}
+
+FSFWDecisionResult FSFWDecisionSelector::Evaluate(const FSFWDecisionSelectorView& View, const FSFWDecisionInput& Input, FRandomStream& Rng)
+{
+	FSFWDecisionResult Result;
+
+	// Nothing in the table is off cooldown: skip room selection, wake when the first one expires
+	if ((View.Sampler->GetTypes() & ~View.CoolingTypes) == 0)
+	{
+		Result.Outcome = ESFWDecisionOutcome::AllCooling;
+		Result.WakeTime = View.NextExpiry;
+		return Result;
+	}
+
+	auto FindOccupiedTier = [&Input](FName RoomId) -> const int32*
+	{
+		const TPair<FName, int32>* Entry = Input.OccupiedRooms.FindByPredicate(
+			[RoomId](const TPair<FName, int32>& Room) { return Room.Key == RoomId; });
+		return Entry ? &Entry->Value : nullptr;
+	};
+
+	int32 Tier = 1;
+
+	// 1) Prefer the Shade's current room as the "where" for decisions.
+	if (!Input.ShadeRoom.IsNone())
+	{
+		Result.RoomId = Input.ShadeRoom;
+		Tier = Input.ShadeRoomTier;
+	}
+	// 2) Fallback to player-occupied rooms if Shade has no known room yet
+	else
+	{
+		if (Input.OccupiedRooms.Num() == 0)
+		{
+			return Result;
+		}
+
+		TArray<FName, TInlineAllocator<16>> OccupiedIds;
+		for (const TPair<FName, int32>& Room : Input.OccupiedRooms)
+		{
+			OccupiedIds.Add(Room.Key);
+		}
+
+		// Widen to rooms a few doors from the players (never safe rooms) when the room graph is known
+		TArray<FName> CandidateRooms;
+		if (Input.Graph && Input.TargetHops > 0)
+		{
+			Input.Graph->GetRoomsWithinHops(OccupiedIds, Input.TargetHops, CandidateRooms);
+			CandidateRooms.RemoveAll([&Input](FName RoomId) { return Input.SafeRooms.Contains(RoomId); });
+		}
+		if (CandidateRooms.Num() == 0)
+		{
+			CandidateRooms = OccupiedIds;
+		}
+
+		UE_LOG(LogTemp, Verbose, TEXT("[DecisionSystem] Evaluate: Candidates=%d"), CandidateRooms.Num());
+
+		Result.RoomId = CandidateRooms[Rng.RandRange(0, CandidateRooms.Num() - 1)];
+
+		const int32* OccupiedTier = FindOccupiedTier(Result.RoomId);
+		Tier = OccupiedTier ? *OccupiedTier : 1;
+	}
+
+	Result.Tier = Tier;
+
+	const FSFWDecisionRowView* Picked = View.Sampler->DrawShared(Tier, ~View.CoolingTypes, Rng, Result.RebuiltAlias);
+	if (Result.RebuiltAlias.bBuilt)
+	{
+		Result.RebuiltTier = Tier;
+		Result.SamplerUsed = View.Sampler;
+	}
+
+	if (!Picked)
+	{
+		// This tier is cooling down; another type expiring may unlock it
+		Result.Outcome = ESFWDecisionOutcome::TierCooling;
+		Result.WakeTime = View.NextExpiry;
+		return Result;
+	}
+
+	Result.Outcome = ESFWDecisionOutcome::Decided;
+	Result.Row = *Picked;
+	Result.WakeTime = Input.Now + Input.IntervalSec;
+	return Result;
+}
@@ -0,0 +1,322 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSimCommandlet.cpp
+
+#include "Core/AnomalySystems/SFW_DecisionSimCommandlet.h"
+#include "Core/AnomalySystems/SFW_CompiledDecisionTables.h"
+#include "Core/AnomalySystems/SFW_DecisionSelector.h"
+#include "Core/Rooms/SFW_RoomGraph.h"
+
+#include "Engine/DataTable.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+	struct FSimPlayer
+	{
+		int32 Room = 0;
+		double NextMoveTime = 0.0;
+
+		/** Seconds this player's sanity lags the round clock. */
+		double TierLag = 0.0;
+	};
+
+	/**
+	 * Room 0 is the safe room (spawn), hanging off room 1. Rooms 1..N-1 form a loop
+	 * with a cross corridor from every fourth room to the one opposite.
+	 */
+	void BuildSyntheticGraph(int32 NumRooms, FSFWRoomGraph& OutGraph)
+	{
+		OutGraph = FSFWRoomGraph();
+		for (int32 i = 0; i < NumRooms; ++i)
+		{
+			OutGraph.RoomIds.Add(FName(*FString::Printf(TEXT("SimRoom_%02d"), i)));
+		}
+
+		auto AddPortal = [&OutGraph](int32 A, int32 B)
+		{
+			FSFWRoomPortal& Portal = OutGraph.Portals.AddDefaulted_GetRef();
+			Portal.RoomA = A;
+			Portal.RoomB = B;
+		};
+
+		AddPortal(0, 1);
+
+		const int32 LoopSize = NumRooms - 1;
+		for (int32 i = 0; i < LoopSize; ++i)
+		{
+			AddPortal(1 + i, 1 + (i + 1) % LoopSize);
+		}
+		for (int32 i = 0; i < LoopSize / 2; i += 4)
+		{
+			AddPortal(1 + i, 1 + i + LoopSize / 2);
+		}
+
+		OutGraph.Finalize();
+	}
+
+	int32 GetPlayerTier(const FSimPlayer& Player, double Now, double TierSec)
+	{
+		// Sanity drops a tier every TierSec and resets each simulated round of three tiers.
+		const double RoundTime = FMath::Fmod(FMath::Max(0.0, Now - Player.TierLag), TierSec * 3.0);
+		return FMath::Clamp(1 + FMath::FloorToInt(RoundTime / TierSec), 1, 3);
+	}
+}
+
+USFW_DecisionSimCommandlet::USFW_DecisionSimCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USFW_DecisionSimCommandlet::Main(const FString& Params)
+{
+	const TCHAR* Cmd = *Params;
+
+	FString TablePath;
+	if (!FParse::Value(Cmd, TEXT("Table="), TablePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[DecisionSim] Missing -Table=<compiled decision tables or DecisionsDT path>."));
+		return 1;
+	}
+
+	FString AnomalyName = TEXT("Binder");
+	FParse::Value(Cmd, TEXT("Anomaly="), AnomalyName);
+	const int64 AnomalyValue = StaticEnum<ESFWAnomalyType>()->GetValueByNameString(AnomalyName);
+	if (AnomalyValue == INDEX_NONE || AnomalyValue >= static_cast<int64>(ESFWAnomalyType::MAX))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[DecisionSim] Unknown anomaly type '%s'."), *AnomalyName);
+		return 1;
+	}
+	const ESFWAnomalyType AnomalyType = static_cast<ESFWAnomalyType>(AnomalyValue);
+
+	// Rows and bias from a compiled asset, or read from DataTables like the actor's fallback
+	const UObject* Source = LoadObject<UObject>(nullptr, *TablePath);
+	const USFW_CompiledDecisionTables* Compiled = Cast<USFW_CompiledDecisionTables>(Source);
+	const UDataTable* DecisionsDT = Cast<UDataTable>(Source);
+
+	TArray<FSFWDecisionRowView> TableRows;
+	TConstArrayView<FSFWDecisionRowView> Rows;
+	FSFWAnomalyProfileView Profile;
+
+	if (Compiled && Compiled->IsCompiled())
+	{
+		Rows = Compiled->GetDecisionRows();
+		Profile = Compiled->GetProfile(AnomalyType);
+	}
+	else if (DecisionsDT && DecisionsDT->GetRowStruct() && DecisionsDT->GetRowStruct()->IsChildOf(FSFWDecisionRow::StaticStruct()))
+	{
+		USFW_CompiledDecisionTables::ReadDecisionRows(DecisionsDT, TableRows);
+		Rows = TableRows;
+
+		FString ProfilesPath;
+		if (FParse::Value(Cmd, TEXT("Profiles="), ProfilesPath))
+		{
+			TArray<FSFWAnomalyProfileView> Profiles;
+			USFW_CompiledDecisionTables::ReadProfiles(LoadObject<UDataTable>(nullptr, *ProfilesPath), Profiles);
+			const int32 Index = static_cast<int32>(AnomalyType);
+			if (Profiles.IsValidIndex(Index))
+			{
+				Profile = Profiles[Index];
+			}
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("[DecisionSim] '%s' is neither compiled decision tables nor a DataTable of FSFWDecisionRow."), *TablePath);
+		return 1;
+	}
+
+	float DoorBias = Profile.DoorBias;
+	float LightBias = Profile.LightBias;
+	FParse::Value(Cmd, TEXT("DoorBias="), DoorBias);
+	FParse::Value(Cmd, TEXT("LightBias="), LightBias);
+
+	int64 NumTicks = 1000000;
+	float IntervalSec = 2.f;
+	int32 NumRooms = 12;
+	int32 NumPlayers = 4;
+	int32 TargetHops = 0;
+	float MoveSec = 30.f;
+	float TierSec = 600.f;
+	int32 Seed = 1;
+	FParse::Value(Cmd, TEXT("Ticks="), NumTicks);
+	FParse::Value(Cmd, TEXT("Interval="), IntervalSec);
+	FParse::Value(Cmd, TEXT("Rooms="), NumRooms);
+	FParse::Value(Cmd, TEXT("Players="), NumPlayers);
+	FParse::Value(Cmd, TEXT("Hops="), TargetHops);
+	FParse::Value(Cmd, TEXT("MoveSec="), MoveSec);
+	FParse::Value(Cmd, TEXT("TierSec="), TierSec);
+	FParse::Value(Cmd, TEXT("Seed="), Seed);
+
+	NumRooms = FMath::Clamp(NumRooms, 3, 200);
+	NumPlayers = FMath::Max(1, NumPlayers);
+	TargetHops = FMath::Max(0, TargetHops);
+	IntervalSec = FMath::Max(0.f, IntervalSec);
+	MoveSec = FMath::Max(1.f, MoveSec);
+	TierSec = FMath::Max(1.f, TierSec);
+
+	FSFWDecisionSelector Selector;
+	if (!Selector.Prepare(Source, Rows, DoorBias, LightBias))
+	{
+		return 1;
+	}
+
+	// ---- Synthetic layout ----
+	FSFWRoomGraph Graph;
+	BuildSyntheticGraph(NumRooms, Graph);
+	const int32 SafeRoom = 0;
+
+	TArray<TArray<int32>> Neighbours;
+	Neighbours.SetNum(NumRooms);
+	for (const FSFWRoomPortal& Portal : Graph.Portals)
+	{
+		Neighbours[Portal.RoomA].Add(Portal.RoomB);
+		Neighbours[Portal.RoomB].Add(Portal.RoomA);
+	}
+
+	// Separate streams so changing the table never changes how players wander.
+	FRandomStream DecisionRng(Seed);
+	FRandomStream LayoutRng(static_cast<int32>(HashCombine(static_cast<uint32>(Seed), 0x5EEDu)));
+
+	TArray<FSimPlayer> Players;
+	Players.SetNum(NumPlayers);
+	for (FSimPlayer& Player : Players)
+	{
+		Player.Room = SafeRoom;
+		Player.NextMoveTime = LayoutRng.FRandRange(0.f, MoveSec);
+		Player.TierLag = LayoutRng.FRandRange(0.f, TierSec);
+	}
+
+	// ---- Stats ----
+	constexpr int32 NumTypes = FSFWDecisionCooldowns::NumTypes;
+	TArray<int64> TypeCount;
+	TArray<double> TypeCoolingSec;
+	TypeCount.SetNumZeroed(NumTypes);
+	TypeCoolingSec.SetNumZeroed(NumTypes);
+	int64 TierCount[4] = {};
+	int64 NumDecisions = 0;
+	int64 NumAllCooling = 0;
+	int64 NumTierBlocked = 0;
+
+	constexpr double MinWakeDelaySec = 0.05;
+	double Now = 0.0;
+	double LastDecisionTime = -TNumericLimits<double>::Max();
+
+	FSFWDecisionInput Input;
+	Input.Graph = &Graph;
+	Input.TargetHops = TargetHops;
+	Input.IntervalSec = IntervalSec;
+	Input.SafeRooms.Add(Graph.RoomIds[SafeRoom]);
+
+	TArray<int32> RoomTier;
+	TArray<int32> RoomPlayers;
+
+	const double StartWall = FPlatformTime::Seconds();
+
+	for (int64 Tick = 0; Tick < NumTicks; ++Tick)
+	{
+		// Players wander to a random neighbouring room every MoveSec or so
+		double NextMoveTime = TNumericLimits<double>::Max();
+		for (FSimPlayer& Player : Players)
+		{
+			if (Player.NextMoveTime <= Now)
+			{
+				const TArray<int32>& Next = Neighbours[Player.Room];
+				Player.Room = Next[LayoutRng.RandRange(0, Next.Num() - 1)];
+				Player.NextMoveTime = Now + LayoutRng.FRandRange(0.5f * MoveSec, 1.5f * MoveSec);
+			}
+			NextMoveTime = FMath::Min(NextMoveTime, Player.NextMoveTime);
+		}
+
+		// Occupancy, as USFW_RoomOccupancySubsystem reports it
+		RoomTier.Init(1, NumRooms);
+		RoomPlayers.Init(0, NumRooms);
+		for (const FSimPlayer& Player : Players)
+		{
+			RoomTier[Player.Room] = FMath::Max(RoomTier[Player.Room], GetPlayerTier(Player, Now, TierSec));
+			++RoomPlayers[Player.Room];
+		}
+
+		// Same input ASFW_AnomalyDecisionSystem builds without a Shade; like the
+		// occupancy subsystem, the safe room never counts as occupied
+		Input.Now = Now;
+		Input.OccupiedRooms.Reset();
+		for (int32 Room = 0; Room < NumRooms; ++Room)
+		{
+			if (Room != SafeRoom && RoomPlayers[Room] > 0)
+			{
+				Input.OccupiedRooms.Emplace(Graph.RoomIds[Room], RoomTier[Room]);
+			}
+		}
+
+		const FSFWDecisionResult Result = Selector.Evaluate(Input, DecisionRng);
+		double WakeTime = Result.WakeTime;
+
+		switch (Result.Outcome)
+		{
+		case ESFWDecisionOutcome::Decided:
+			Selector.Commit(Result.Row, Now);
+			LastDecisionTime = Now;
+
+			++NumDecisions;
+			++TypeCount[static_cast<int32>(Result.Row.Type)];
+			TypeCoolingSec[static_cast<int32>(Result.Row.Type)] += FMath::Max(0.f, Result.Row.CooldownSec);
+			++TierCount[FMath::Clamp(Result.Tier, 0, 3)];
+			break;
+		case ESFWDecisionOutcome::AllCooling:
+			++NumAllCooling;
+			break;
+		case ESFWDecisionOutcome::TierCooling:
+			++NumTierBlocked;
+			break;
+		default:
+			// No target: nothing changes until a player moves
+			break;
+		}
+
+		// Occupancy changes wake the system too; pacing and the timer floor still apply
+		WakeTime = FMath::Min(WakeTime, NextMoveTime);
+		Now = FMath::Max3(WakeTime, Now + MinWakeDelaySec, LastDecisionTime + IntervalSec);
+	}
+
+	const double WallSec = FMath::Max(FPlatformTime::Seconds() - StartWall, UE_DOUBLE_SMALL_NUMBER);
+	const double SimSec = FMath::Max(Now, UE_DOUBLE_SMALL_NUMBER);
+
+	// ---- Report ----
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] %s  DoorBias=%.2f LightBias=%.2f  Rooms=%d Players=%d Hops=%d Interval=%.2fs Seed=%d"),
+		*Source->GetName(), DoorBias, LightBias, NumRooms, NumPlayers, TargetHops, IntervalSec, Seed);
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] %lld ticks, %lld decisions over %.0f simulated s (%.1f h) in %.3f wall s"),
+		NumTicks, NumDecisions, SimSec, SimSec / 3600.0, WallSec);
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] Throughput: %.0f ticks/s, %.0f decisions/s (wall); %.3f decisions per simulated s"),
+		NumTicks / WallSec, NumDecisions / WallSec, NumDecisions / SimSec);
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] Idle ticks: %lld all types cooling (%.1f%%), %lld target tier cooling (%.1f%%)"),
+		NumAllCooling, 100.0 * NumAllCooling / FMath::Max<int64>(NumTicks, 1),
+		NumTierBlocked, 100.0 * NumTierBlocked / FMath::Max<int64>(NumTicks, 1));
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] Decisions by tier: T1=%lld T2=%lld T3=%lld"),
+		TierCount[1], TierCount[2], TierCount[3]);
+
+	UE_LOG(LogTemp, Display, TEXT("[DecisionSim] %-22s %10s %8s %10s"), TEXT("Type"), TEXT("Count"), TEXT("Share"), TEXT("Cooling"));
+	const UEnum* Enum = StaticEnum<ESFWDecision>();
+	for (int32 i = 0; i < NumTypes; ++i)
+	{
+		if (TypeCount[i] == 0)
+		{
+			continue;
+		}
+
+		// The last cooldown of each type may run past the end of the simulation
+		const ESFWDecision Type = static_cast<ESFWDecision>(i);
+		const double Cooling = TypeCoolingSec[i] - Selector.GetCooldowns().GetRemaining(Type, Now);
+
+		UE_LOG(LogTemp, Display, TEXT("[DecisionSim] %-22s %10lld %7.2f%% %9.2f%%"),
+			*Enum->GetNameStringByValue(i),
+			TypeCount[i],
+			100.0 * TypeCount[i] / FMath::Max<int64>(NumDecisions, 1),
+			100.0 * FMath::Clamp(Cooling / SimSec, 0.0, 1.0));
+	}
+
+	return 0;
+}
@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_EMFSourceSubsystem.cpp
+
+#include "Core/AnomalySystems/SFW_EMFSourceSubsystem.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+USFW_EMFSourceSubsystem* USFW_EMFSourceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_EMFSourceSubsystem>() : nullptr;
+}
+
+bool USFW_EMFSourceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_EMFSourceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return; // EMF scanning is server-only
+	}
+
+	// One-time pickup of designer-tagged permanent sources.
+	static const FName EMFTag(TEXT("EMF_Source"));
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		if (It->ActorHasTag(EMFTag))
+		{
+			RegisterSource(*It, 0.f);
+		}
+	}
+}
+
+void USFW_EMFSourceSubsystem::Deinitialize()
+{
+	Sources.Empty();
+	IndexByActor.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntPoint USFW_EMFSourceSubsystem::CellFor(const FVector& Location)
+{
+	return FIntPoint(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void USFW_EMFSourceSubsystem::AddToCell(const FIntPoint& Cell, int32 SourceIndex)
+{
+	Cells.FindOrAdd(Cell).Add(SourceIndex);
+}
+
+void USFW_EMFSourceSubsystem::RemoveFromCell(const FIntPoint& Cell, int32 SourceIndex)
+{
+	if (TArray<int32, TInlineAllocator<4>>* Bucket = Cells.Find(Cell))
+	{
+		Bucket->RemoveSingleSwap(SourceIndex);
+		if (Bucket->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void USFW_EMFSourceSubsystem::RemoveSourceAt(int32 SourceIndex)
+{
+	const FSource& Source = Sources[SourceIndex];
+	RemoveFromCell(Source.Cell, SourceIndex);
+	IndexByActor.Remove(Source.Actor);
+	Sources.RemoveAt(SourceIndex);
+}
+
+void USFW_EMFSourceSubsystem::RegisterSource(AActor* Source, float Seconds, float Strength)
+{
+	UWorld* World = GetWorld();
+	if (!World || !IsValid(Source))
+	{
+		return;
+	}
+
+	const double ExpireTime = (Seconds > 0.f) ? World->GetTimeSeconds() + Seconds : 0.0;
+
+	if (const int32* Existing = IndexByActor.Find(Source))
+	{
+		FSource& S = Sources[*Existing];
+		if (S.ExpireTime > 0.0)
+		{
+			S.ExpireTime = (ExpireTime > 0.0) ? FMath::Max(S.ExpireTime, ExpireTime) : 0.0;
+		}
+		S.Strength = Strength;
+		return;
+	}
+
+	FSource S;
+	S.Actor = Source;
+	S.ExpireTime = ExpireTime;
+	S.Strength = Strength;
+	S.Cell = CellFor(Source->GetActorLocation());
+
+	const USceneComponent* Root = Source->GetRootComponent();
+	S.bMovable = Root && Root->Mobility == EComponentMobility::Movable;
+
+	const int32 Index = Sources.Add(S);
+	IndexByActor.Add(Source, Index);
+	AddToCell(S.Cell, Index);
+}
+
+void USFW_EMFSourceSubsystem::UnregisterSource(AActor* Source)
+{
+	if (const int32* Index = IndexByActor.Find(Source))
+	{
+		RemoveSourceAt(*Index);
+	}
+}
+
+bool USFW_EMFSourceSubsystem::IsSource(const AActor* Source) const
+{
+	return IndexByActor.Contains(Source);
+}
+
+void USFW_EMFSourceSubsystem::RefreshSources()
+{
+	if (LastRefreshFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastRefreshFrame = GFrameCounter;
+
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+
+	for (auto It = Sources.CreateIterator(); It; ++It)
+	{
+		FSource& S = *It;
+		const AActor* Actor = S.Actor.Get();
+
+		if (!Actor || (S.ExpireTime > 0.0 && Now >= S.ExpireTime))
+		{
+			RemoveSourceAt(It.GetIndex());
+			continue;
+		}
+
+		if (S.bMovable)
+		{
+			const FIntPoint NewCell = CellFor(Actor->GetActorLocation());
+			if (NewCell != S.Cell)
+			{
+				RemoveFromCell(S.Cell, It.GetIndex());
+				S.Cell = NewCell;
+				AddToCell(NewCell, It.GetIndex());
+			}
+		}
+	}
+}
+
+float USFW_EMFSourceSubsystem::QueryStrongestSignal(const FVector& Origin, float Radius, const AActor* Ignore)
+{
+	if (Radius <= 0.f || Sources.Num() == 0)
+	{
+		return 0.f;
+	}
+
+	RefreshSources();
+
+	const FIntPoint Min = CellFor(Origin - FVector(Radius));
+	const FIntPoint Max = CellFor(Origin + FVector(Radius));
+
+	float Strongest = 0.f;
+
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const TArray<int32, TInlineAllocator<4>>* Bucket = Cells.Find(FIntPoint(X, Y));
+			if (!Bucket)
+			{
+				continue;
+			}
+
+			for (const int32 Index : *Bucket)
+			{
+				const FSource& S = Sources[Index];
+				const AActor* Actor = S.Actor.Get();
+				if (!Actor || Actor == Ignore)
+				{
+					continue;
+				}
+
+				const float Dist = FVector::Dist(Origin, Actor->GetActorLocation());
+				if (Dist > Radius)
+				{
+					continue;
+				}
+
+				const float Signal = S.Strength * FMath::Clamp((Radius - Dist) / Radius, 0.f, 1.f);
+				Strongest = FMath::Max(Strongest, Signal);
+			}
+		}
+	}
+
+	return FMath::Clamp(Strongest, 0.f, 1.f);
+}
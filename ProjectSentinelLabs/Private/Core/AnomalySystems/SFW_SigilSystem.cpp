@@ -2,7 +2,9 @@
 
 #include "Core/AnomalySystems/SFW_SigilSystem.h"
 #include "Core/AnomalySystems/SFW_SigilActor.h"
-#include "Core/Rooms/RoomVolume.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 
 #include "EngineUtils.h"
 #include "Engine/World.h"
@@ -22,6 +24,21 @@ void ASFW_SigilSystem::BeginPlay()
 	{
 		GatherAllSigils();
 	}
+
+	if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterSigilSystem(this);
+	}
+}
+
+void ASFW_SigilSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterSigilSystem(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASFW_SigilSystem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -63,20 +80,8 @@ void ASFW_SigilSystem::GatherSigilsInRoom(FName RoomId, TArray<ASFW_SigilActor*>
 		return;
 	}
 
-	ARoomVolume* TargetRoom = nullptr;
-
-	// Find the room volume by RoomId
-	for (TActorIterator<ARoomVolume> It(World); It; ++It)
-	{
-		ARoomVolume* Vol = *It;
-		if (Vol && Vol->RoomId == RoomId)
-		{
-			TargetRoom = Vol;
-			break;
-		}
-	}
-
-	if (!TargetRoom)
+	const USFW_RoomIndexSubsystem* RoomIndex = USFW_RoomIndexSubsystem::Get(this);
+	if (!RoomIndex || RoomIndex->GetVolumesForRoomId(RoomId).Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning,
 			TEXT("[SigilSystem] No ARoomVolume found for RoomId '%s'"),
@@ -90,9 +95,7 @@ void ASFW_SigilSystem::GatherSigilsInRoom(FName RoomId, TArray<ASFW_SigilActor*>
 		GatherAllSigils();
 	}
 
-	// Use the room's component bounds to test positions
-	const FBox RoomBounds = TargetRoom->GetComponentsBoundingBox(true);
-
+	// Resolve positions through the room index (baked grid / exact volume test)
 	for (TWeakObjectPtr<ASFW_SigilActor>& WeakSigil : AllSigils)
 	{
 		ASFW_SigilActor* Sigil = WeakSigil.Get();
@@ -102,7 +105,7 @@ void ASFW_SigilSystem::GatherSigilsInRoom(FName RoomId, TArray<ASFW_SigilActor*>
 		}
 
 		const FVector Loc = Sigil->GetActorLocation();
-		if (RoomBounds.IsInside(Loc))
+		if (RoomIndex->IsLocationInRoom(RoomId, Loc))
 		{
 			OutSigils.Add(Sigil);
 		}
@@ -131,10 +134,12 @@ void ASFW_SigilSystem::BuildRandomLayoutFromPool(const TArray<ASFW_SigilActor*>&
 		return;
 	}
 
+	FRandomStream& Rng = USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Sigils);
+
 	// Randomly pick RequiredVisibleSigils from Pool
 	while (ActiveSigils.Num() < RequiredVisibleSigils && Pool.Num() > 0)
 	{
-		const int32 Index = FMath::RandRange(0, Pool.Num() - 1);
+		const int32 Index = Rng.RandRange(0, Pool.Num() - 1);
 		ASFW_SigilActor* Chosen = Pool[Index];
 		ActiveSigils.Add(Chosen);
 		Pool.RemoveAtSwap(Index);
@@ -161,7 +166,7 @@ void ASFW_SigilSystem::BuildRandomLayoutFromPool(const TArray<ASFW_SigilActor*>&
 
 	for (int32 i = 0; i < RequiredRealSigils && RealPool.Num() > 0; ++i)
 	{
-		const int32 Index = FMath::RandRange(0, RealPool.Num() - 1);
+		const int32 Index = Rng.RandRange(0, RealPool.Num() - 1);
 		ASFW_SigilActor* RealSigil = RealPool[Index];
 		if (RealSigil)
 		{
@@ -170,6 +175,9 @@ void ASFW_SigilSystem::BuildRandomLayoutFromPool(const TArray<ASFW_SigilActor*>&
 		RealPool.RemoveAtSwap(Index);
 	}
 
+	CleansedSigils.Reset();
+	RebuildQueryIndex();
+
 	UE_LOG(LogTemp, Log,
 		TEXT("[SigilSystem] Initialized layout: Active=%d Real=%d"),
 		ActiveSigils.Num(),
@@ -257,6 +265,9 @@ void ASFW_SigilSystem::ResetPuzzle()
 	NumRealCleansed = 0;
 	bPuzzleActive = false;
 	bPuzzleComplete = false;
+
+	CleansedSigils.Reset();
+	RebuildQueryIndex();
 }
 
 void ASFW_SigilSystem::NotifySigilCleansed(ASFW_SigilActor* Sigil, bool bWasReal)
@@ -276,6 +287,9 @@ void ASFW_SigilSystem::NotifySigilCleansed(ASFW_SigilActor* Sigil, bool bWasReal
 	{
 		NumRealCleansed++;
 
+		CleansedSigils.Add(Sigil);
+		RebuildQueryIndex();
+
 		UE_LOG(LogTemp, Log,
 			TEXT("[SigilSystem] Real sigil cleansed. Count = %d / %d"),
 			NumRealCleansed,
@@ -299,3 +313,70 @@ void ASFW_SigilSystem::NotifySigilCleansed(ASFW_SigilActor* Sigil, bool bWasReal
 		OnPuzzleFailed.Broadcast();
 	}
 }
+
+void ASFW_SigilSystem::RebuildQueryIndex()
+{
+	QueryIndex.Reset();
+	QueryBounds = FSphere(ForceInit);
+
+	TArray<FVector, TInlineAllocator<8>> Points;
+	for (const TWeakObjectPtr<ASFW_SigilActor>& WeakSigil : ActiveSigils)
+	{
+		ASFW_SigilActor* S = WeakSigil.Get();
+		if (!S || !S->IsActive() || CleansedSigils.Contains(WeakSigil))
+		{
+			continue;
+		}
+
+		FSigilQueryEntry& Entry = QueryIndex.AddDefaulted_GetRef();
+		Entry.Sigil = S;
+		Entry.Location = S->GetActorLocation();
+		Points.Add(Entry.Location);
+	}
+
+	if (Points.Num() > 0)
+	{
+		QueryBounds = FSphere(Points.GetData(), Points.Num());
+	}
+}
+
+void ASFW_SigilSystem::QuerySigilsInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngleDeg,
+	TArray<ASFW_SigilActor*>& OutSigils) const
+{
+	OutSigils.Reset();
+
+	if (QueryIndex.Num() == 0 || Range <= 0.f)
+	{
+		return;
+	}
+
+	// Coarse: the whole layout is out of reach.
+	if (FVector::DistSquared(Origin, QueryBounds.Center) > FMath::Square(Range + QueryBounds.W))
+	{
+		return;
+	}
+
+	const float CosThresh = FMath::Cos(FMath::DegreesToRadians(ConeHalfAngleDeg));
+	const float RangeSq = Range * Range;
+
+	for (const FSigilQueryEntry& Entry : QueryIndex)
+	{
+		const FVector To = Entry.Location - Origin;
+		const float DistSq = To.SizeSquared();
+		if (DistSq > RangeSq)
+		{
+			continue;
+		}
+
+		if (FVector::DotProduct(Direction, To.GetSafeNormal()) < CosThresh)
+		{
+			continue;
+		}
+
+		ASFW_SigilActor* Sigil = Entry.Sigil.Get();
+		if (Sigil && Sigil->IsActive())
+		{
+			OutSigils.Add(Sigil);
+		}
+	}
+}
@@ -1,6 +1,7 @@
 // SFW_AnomalyPropComponent.cpp
 
 #include "Core/Components/SFW_AnomalyPropComponent.h"
+#include "Core/AnomalySystems/SFW_AnomalyPropRegistrySubsystem.h"
 
 #include "Core/Lights/SFW_PowerLibrary.h"
 #include "GameFramework/Actor.h"
@@ -17,6 +18,26 @@ void USFW_AnomalyPropComponent::BeginPlay()
 {
 	Super::BeginPlay();
 	// Cache at pulse start so props that move still work.
+
+	// Decisions only run on the server, so only the server needs the room buckets
+	AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority())
+	{
+		if (USFW_AnomalyPropRegistrySubsystem* Registry = USFW_AnomalyPropRegistrySubsystem::Get(this))
+		{
+			Registry->RegisterProp(this);
+		}
+	}
+}
+
+void USFW_AnomalyPropComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USFW_AnomalyPropRegistrySubsystem* Registry = USFW_AnomalyPropRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterProp(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void USFW_AnomalyPropComponent::TriggerAnomalyPulse(float PulseDurationSec)
@@ -1,11 +1,15 @@
 // Fill out your copyright...
 
 #include "Core/Components/SFW_LampControllerComponent.h"
+#include "Core/Lights/SFW_LampRegistrySubsystem.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "Components/MeshComponent.h"
 #include "Components/LightComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Misc/Crc.h"
 #include "TimerManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogLampCtrl, Log, All);
@@ -21,12 +25,53 @@ void USFW_LampControllerComponent::BeginPlay()
 	Super::BeginPlay();
 	CreateMIDsIfNeeded();
 	ApplyState();
+
+	// Spawned lamps are named differently on each machine; clients take the server's salt
+	const AActor* Owner = GetOwner();
+	if (Owner && (Owner->HasAuthority() || Owner->IsNetStartupActor()))
+	{
+		FlickerSalt = static_cast<int32>(FCrc::StrCrc32(*UWorld::RemovePIEPrefix(GetPathName())));
+	}
+
+	if (USFW_LampRegistrySubsystem* Registry = USFW_LampRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterLamp(this);
+	}
+}
+
+void USFW_LampControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USFW_LampRegistrySubsystem* Registry = USFW_LampRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterLamp(this);
+	}
+
+	if (UWorld* W = GetWorld())
+	{
+		W->GetTimerManager().ClearTimer(FlickerTimer);
+		W->GetTimerManager().ClearTimer(RestoreTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void USFW_LampControllerComponent::SetRoomId(FName NewRoomId)
+{
+	if (RoomId == NewRoomId) return;
+
+	RoomId = NewRoomId;
+
+	if (USFW_LampRegistrySubsystem* Registry = USFW_LampRegistrySubsystem::Get(this))
+	{
+		Registry->UpdateLampRoom(this);
+	}
 }
 
 void USFW_LampControllerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(USFW_LampControllerComponent, State);
+	DOREPLIFETIME_CONDITION(USFW_LampControllerComponent, FlickerSalt, COND_InitialOnly);
 }
 
 void USFW_LampControllerComponent::OnRep_State()
@@ -133,6 +178,8 @@ void USFW_LampControllerComponent::StartFlicker()
 
 void USFW_LampControllerComponent::StopFlicker()
 {
+	bSynthFlickerActive = false;
+
 	if (UWorld* W = GetWorld())
 	{
 		W->GetTimerManager().ClearTimer(FlickerTimer);
@@ -141,66 +188,137 @@ void USFW_LampControllerComponent::StopFlicker()
 
 void USFW_LampControllerComponent::TickFlickerOnce()
 {
+	const FFlickerFrame Frame = DrawFlickerFrame(USFW_RoundRandomSubsystem::GetStream(this, SFWRandomStreams::Lamps));
+	ApplyFlickerFrame(Frame);
+
+	if (UWorld* W = GetWorld())
+	{
+		W->GetTimerManager().SetTimer(FlickerTimer, this, &USFW_LampControllerComponent::TickFlickerOnce, Frame.Interval, false);
+	}
+}
+
+USFW_LampControllerComponent::FFlickerFrame USFW_LampControllerComponent::DrawFlickerFrame(FRandomStream& Rng) const
+{
+	FFlickerFrame Frame;
+
 	// 20% chance of full-dark pop
-	const bool bPopOff = FMath::FRand() < 0.20f;
+	Frame.bPopOff = Rng.FRand() < 0.20f;
 
-	float TargetEmissive = 0.f;
 	if (bUseMaterialSwap)
 	{
-		// If using swap, emulate binary behaviour: pick On/Off
-		if (bPopOff || bBinaryFlicker)
-		{
-			// exact off or exact on
-			if (bPopOff) ApplyMaterialOff(); else ApplyMaterialOn();
-			TargetEmissive = bPopOff ? 0.f : OnEmissive; // for logging symmetry
-		}
-		else
-		{
-			// analog look not supported with swap; just bias to On
-			ApplyMaterialOn();
-			TargetEmissive = OnEmissive;
-		}
+		// Swap can only show exact on / exact off; the analog look is biased to On
+		Frame.Emissive = Frame.bPopOff ? 0.f : OnEmissive;
 	}
 	else
 	{
-		// Emissive path
 		const float MaxE = FMath::Max(1.f, OnEmissive);
-
-		if (bBinaryFlicker)
+		if (Frame.bPopOff)
 		{
-			TargetEmissive = bPopOff ? 0.f : MaxE;
+			Frame.Emissive = 0.f;
 		}
 		else
 		{
-			TargetEmissive = bPopOff ? 0.f : FMath::FRandRange(0.25f * MaxE, MaxE);
+			Frame.Emissive = bBinaryFlicker ? MaxE : Rng.FRandRange(0.25f * MaxE, MaxE);
 		}
-		ApplyEmissive(TargetEmissive);
 	}
 
-	// Light: keep visible unless were snapping to off
+	// Light: keep visible unless we're snapping to off
+	const bool bIsOffNow = (Frame.Emissive <= OffSnapThreshold);
+	Frame.LightMultiplier = bIsOffNow
+		? 0.0f
+		: (bBinaryFlicker ? 1.0f : Rng.FRandRange(0.25f, 1.0f));
+
+	// A zero interval would clear the timer instead of re-arming it
+	Frame.Interval = FMath::Max(0.01f, Rng.FRandRange(FlickerIntervalMin, FlickerIntervalMax));
+	return Frame;
+}
+
+void USFW_LampControllerComponent::ApplyFlickerFrame(const FFlickerFrame& Frame)
+{
+	if (bUseMaterialSwap)
+	{
+		if (Frame.bPopOff) ApplyMaterialOff(); else ApplyMaterialOn();
+	}
+	else
+	{
+		ApplyEmissive(Frame.Emissive);
+	}
+
 	if (bControlLightIntensity)
 	{
 		if (ULightComponent* L = ResolveLight())
 		{
 			if (BaseLightIntensity < 0.f) BaseLightIntensity = L->Intensity;
 
-			const bool bIsOffNow = (TargetEmissive <= OffSnapThreshold);
-			const float Mult = bIsOffNow
-				? 0.0f
-				: (bBinaryFlicker ? 1.0f : FMath::FRandRange(0.25f, 1.0f));
-
-			L->SetIntensity(BaseLightIntensity * Mult);
+			const bool bIsOffNow = (Frame.Emissive <= OffSnapThreshold);
+			L->SetIntensity(BaseLightIntensity * Frame.LightMultiplier);
 			L->SetVisibility(!bIsOffNow);
 			//UE_LOG(LogLampCtrl, Log, TEXT("[%s] Flicker light mult=%.2f (base %.2f)"),
-				//*GetOwner()->GetName(), Mult, BaseLightIntensity);
+				//*GetOwner()->GetName(), Frame.LightMultiplier, BaseLightIntensity);
 		}
 	}
+}
 
-	const float Interval = FMath::FRandRange(FlickerIntervalMin, FlickerIntervalMax);
-	if (UWorld* W = GetWorld())
+double USFW_LampControllerComponent::GetServerTime() const
+{
+	const UWorld* W = GetWorld();
+	if (!W) return 0.0;
+
+	const AGameStateBase* GS = W->GetGameState();
+	return GS ? GS->GetServerWorldTimeSeconds() : W->GetTimeSeconds();
+}
+
+void USFW_LampControllerComponent::PlaySynthesizedFlicker(double StartTime, float Duration, int32 Seed)
+{
+	if (State != ELampState::On || Duration <= 0.f || !GetOwner() || !GetWorld()) return;
+
+	// Salted per lamp so lamps in one room don't flicker in lockstep
+	SynthRng.Initialize(static_cast<int32>(HashCombine(static_cast<uint32>(Seed), static_cast<uint32>(FlickerSalt))));
+	SynthEndTime = StartTime + Duration;
+
+	// Arrived late (packet delay): skip the frames that already played
+	const double Now = GetServerTime();
+	double FrameTime = StartTime;
+	FFlickerFrame Frame = DrawFlickerFrame(SynthRng);
+	while (FrameTime + Frame.Interval <= Now && FrameTime + Frame.Interval < SynthEndTime)
+	{
+		FrameTime += Frame.Interval;
+		Frame = DrawFlickerFrame(SynthRng);
+	}
+
+	if (Now >= SynthEndTime)
+	{
+		return;
+	}
+
+	StopFlicker();
+	bSynthFlickerActive = true;
+	ApplyFlickerFrame(Frame);
+
+	SynthNextFrameTime = FrameTime + Frame.Interval;
+	GetWorld()->GetTimerManager().SetTimer(FlickerTimer, this, &USFW_LampControllerComponent::TickSynthesizedFlicker,
+		static_cast<float>(FMath::Max(FMath::Min(SynthNextFrameTime, SynthEndTime) - Now, 0.01)), false);
+}
+
+void USFW_LampControllerComponent::TickSynthesizedFlicker()
+{
+	if (!bSynthFlickerActive) return;
+
+	if (SynthNextFrameTime >= SynthEndTime)
 	{
-		W->GetTimerManager().SetTimer(FlickerTimer, this, &USFW_LampControllerComponent::TickFlickerOnce, Interval, false);
+		// Pattern over: back to the replicated state
+		ApplyState();
+		return;
 	}
+
+	const FFlickerFrame Frame = DrawFlickerFrame(SynthRng);
+	ApplyFlickerFrame(Frame);
+
+	// Schedule against the pattern's own clock so timer slop doesn't accumulate
+	const double Now = GetServerTime();
+	SynthNextFrameTime += Frame.Interval;
+	GetWorld()->GetTimerManager().SetTimer(FlickerTimer, this, &USFW_LampControllerComponent::TickSynthesizedFlicker,
+		static_cast<float>(FMath::Max(FMath::Min(SynthNextFrameTime, SynthEndTime) - Now, 0.01)), false);
 }
 
 void USFW_LampControllerComponent::ApplyEmissive(float Scalar)
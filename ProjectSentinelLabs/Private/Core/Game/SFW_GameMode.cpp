@@ -6,6 +6,7 @@
 #include "Core/Game/SFW_GameState.h"
 #include "Core/Game/SFW_GameInstance.h"
 #include "Core/Game/SFW_PlayerState.h"
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
 #include "PlayerCharacter/Data/SFW_AgentCatalog.h"
 #include "Engine/World.h"
 #include "Core/Game/SFW_StagingTypes.h"
@@ -44,7 +45,7 @@ void ASFW_GameMode::StartRound()
 
 	if (ASFW_GameState* GS = GetGameState<ASFW_GameState>())
 	{
-		const int32 Seed = FMath::Rand(); // later you can make this deterministic
+		const int32 Seed = USFW_RoundRandomSubsystem::ChooseRoundSeed(); // -SFWRoundSeed=N to reproduce a run
 		GS->BeginRound(Now, Seed);
 		GS->AnomalyAggression = 0.f;
 	}
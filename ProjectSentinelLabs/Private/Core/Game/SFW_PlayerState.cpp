@@ -3,9 +3,10 @@
 #include "Core/Game/SFW_PlayerState.h"
 #include "Net/UnrealNetwork.h"
 #include "PlayerCharacter/Data/SFW_AgentCatalog.h"
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
+#include "Core/AnomalySystems/SFW_AnomalyRegistrySubsystem.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
-#include "EngineUtils.h"
 #include "GameFramework/Pawn.h"
 
 ASFW_PlayerState::ASFW_PlayerState() {}
@@ -475,6 +476,11 @@ void ASFW_PlayerState::RecomputeAndApplySanityTier()
 	{
 		SanityTier = NewTier;   // replicated
 		OnRep_SanityTier();     // fire locally on server
+
+		if (USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this))
+		{
+			Occupancy->NotifySanityTierChanged(this);
+		}
 	}
 }
 
@@ -504,29 +510,16 @@ void ASFW_PlayerState::SanityTick()
 		// amplify drain near Shade
 		if (Delta < 0.f && ShadeClass)
 		{
-			UWorld* W = GetWorld();
-			APawn* MyPawn = nullptr;
-
-			for (TActorIterator<APawn> ItPawn(W); ItPawn; ++ItPawn)
-			{
-				if (ItPawn->GetPlayerState() == this)
-				{
-					MyPawn = *ItPawn;
-					break;
-				}
-			}
+			const APawn* MyPawn = GetPawn();
+			const USFW_AnomalyRegistrySubsystem* Registry = USFW_AnomalyRegistrySubsystem::Get(this);
+			const AActor* Shade = Registry ? Registry->GetActiveShade() : nullptr;
 
-			if (MyPawn)
+			if (MyPawn && Shade && Shade->IsA(ShadeClass))
 			{
 				const float R2 = ShadeRadius * ShadeRadius;
-				for (TActorIterator<AActor> ItShade(W, ShadeClass); ItShade; ++ItShade)
+				if (FVector::DistSquared(Shade->GetActorLocation(), MyPawn->GetActorLocation()) <= R2)
 				{
-					AActor* Shade = *ItShade;
-					if (FVector::DistSquared(Shade->GetActorLocation(), MyPawn->GetActorLocation()) <= R2)
-					{
-						Delta *= ShadeDrainMultiplier;
-						break;
-					}
+					Delta *= ShadeDrainMultiplier;
 				}
 			}
 		}
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoundRandomSubsystem.cpp
+
+#include "Core/Game/SFW_RoundRandomSubsystem.h"
+#include "Core/Game/SFW_GameState.h"
+
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Crc.h"
+#include "Misc/Parse.h"
+
+namespace SFWRandomStreams
+{
+	const FName AnomalyController(TEXT("AnomalyController"));
+	const FName Decisions(TEXT("Decisions"));
+	const FName Lamps(TEXT("Lamps"));
+	const FName Sigils(TEXT("Sigils"));
+	const FName Props(TEXT("Props"));
+	const FName Patrol(TEXT("Patrol"));
+}
+
+// Stable across runs, unlike GetTypeHash(FName) which depends on name table order.
+static int32 DeriveStreamSeed(int32 RoundSeed, FName StreamName)
+{
+	const uint32 NameHash = FCrc::StrCrc32(*StreamName.ToString());
+	return static_cast<int32>(HashCombine(static_cast<uint32>(RoundSeed), NameHash));
+}
+
+USFW_RoundRandomSubsystem* USFW_RoundRandomSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_RoundRandomSubsystem>() : nullptr;
+}
+
+FRandomStream& USFW_RoundRandomSubsystem::GetStream(const UObject* WorldContextObject, FName StreamName)
+{
+	if (USFW_RoundRandomSubsystem* Subsystem = Get(WorldContextObject))
+	{
+		return Subsystem->GetStream(StreamName);
+	}
+
+	static FRandomStream Unseeded(FMath::Rand());
+	return Unseeded;
+}
+
+int32 USFW_RoundRandomSubsystem::ChooseRoundSeed()
+{
+	int32 Seed = 0;
+	if (FParse::Value(FCommandLine::Get(), TEXT("SFWRoundSeed="), Seed))
+	{
+		UE_LOG(LogTemp, Display, TEXT("[RoundRandom] Using round seed %d from the command line."), Seed);
+		return Seed;
+	}
+
+	// 0 is what an unstarted GameState replicates; keep it out of real rounds.
+	do
+	{
+		Seed = FMath::Rand();
+	}
+	while (Seed == 0);
+
+	return Seed;
+}
+
+bool USFW_RoundRandomSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_RoundRandomSubsystem::Deinitialize()
+{
+	Streams.Empty();
+	CurrentSeed = 0;
+
+	Super::Deinitialize();
+}
+
+void USFW_RoundRandomSubsystem::SyncWithRoundSeed()
+{
+	const UWorld* World = GetWorld();
+	const ASFW_GameState* GS = World ? World->GetGameState<ASFW_GameState>() : nullptr;
+	if (!GS || GS->RoundSeed == CurrentSeed)
+	{
+		return;
+	}
+
+	CurrentSeed = GS->RoundSeed;
+	for (TPair<FName, FRandomStream>& Pair : Streams)
+	{
+		Pair.Value.Initialize(DeriveStreamSeed(CurrentSeed, Pair.Key));
+	}
+}
+
+FRandomStream& USFW_RoundRandomSubsystem::GetStream(FName StreamName)
+{
+	SyncWithRoundSeed();
+
+	if (FRandomStream* Stream = Streams.Find(StreamName))
+	{
+		return *Stream;
+	}
+
+	return Streams.Add(StreamName, FRandomStream(DeriveStreamSeed(CurrentSeed, StreamName)));
+}
@@ -4,6 +4,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Core/Components/SFW_LampControllerComponent.h"
 #include "Core/Rooms/RoomVolume.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "EngineUtils.h"
 #include "Engine/World.h"
@@ -14,6 +15,13 @@ namespace
 	{
 		if (!World || !Actor) return NAME_None;
 
+		// Game worlds: answer from the room index by lamp location.
+		if (const USFW_RoomIndexSubsystem* Index = World->GetSubsystem<USFW_RoomIndexSubsystem>())
+		{
+			return Index->FindRoomIdAtLocation(Actor->GetActorLocation());
+		}
+
+		// Editor worlds have no index; fall back to scanning the rooms.
 		for (TActorIterator<ARoomVolume> It(World); It; ++It)
 		{
 			const ARoomVolume* Vol = *It;
@@ -52,7 +60,7 @@ void ASFW_LampBase::OnConstruction(const FTransform& Transform)
 	// Always push actor RoomId into the component (what PowerLibrary filters on)
 	if (Lamp)
 	{
-		Lamp->RoomId = RoomId;
+		Lamp->SetRoomId(RoomId);
 
 		// sensible default for emissive if not set per-instance
 		if (Lamp->EmissiveParamName.IsNone())
@@ -73,7 +81,7 @@ void ASFW_LampBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChange
 
 	if (Changed == GET_MEMBER_NAME_CHECKED(ASFW_LampBase, RoomId))
 	{
-		if (Lamp) { Lamp->RoomId = RoomId; }
+		if (Lamp) { Lamp->SetRoomId(RoomId); }
 	}
 }
 #endif
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Core/Lights/SFW_LampRegistrySubsystem.h"
+#include "Core/Components/SFW_LampControllerComponent.h"
+#include "Engine/World.h"
+
+USFW_LampRegistrySubsystem* USFW_LampRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_LampRegistrySubsystem>() : nullptr;
+}
+
+bool USFW_LampRegistrySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_LampRegistrySubsystem::Deinitialize()
+{
+	AllLamps.Reset();
+	LampsByRoom.Reset();
+	RegisteredRoom.Reset();
+
+	Super::Deinitialize();
+}
+
+void USFW_LampRegistrySubsystem::RegisterLamp(USFW_LampControllerComponent* Lamp)
+{
+	if (!Lamp || RegisteredRoom.Contains(Lamp))
+	{
+		return;
+	}
+
+	AllLamps.Add(Lamp);
+	RegisteredRoom.Add(Lamp, Lamp->RoomId);
+	LampsByRoom.FindOrAdd(Lamp->RoomId).Add(Lamp);
+}
+
+void USFW_LampRegistrySubsystem::UnregisterLamp(USFW_LampControllerComponent* Lamp)
+{
+	FName OldRoom;
+	if (!Lamp || !RegisteredRoom.RemoveAndCopyValue(Lamp, OldRoom))
+	{
+		return;
+	}
+
+	AllLamps.RemoveSingleSwap(Lamp);
+
+	if (TArray<USFW_LampControllerComponent*>* Bucket = LampsByRoom.Find(OldRoom))
+	{
+		Bucket->RemoveSingleSwap(Lamp);
+		if (Bucket->Num() == 0)
+		{
+			LampsByRoom.Remove(OldRoom);
+		}
+	}
+}
+
+void USFW_LampRegistrySubsystem::UpdateLampRoom(USFW_LampControllerComponent* Lamp)
+{
+	const FName* OldRoom = Lamp ? RegisteredRoom.Find(Lamp) : nullptr;
+	if (!OldRoom || *OldRoom == Lamp->RoomId)
+	{
+		return;
+	}
+
+	UnregisterLamp(Lamp);
+	RegisterLamp(Lamp);
+}
+
+const TArray<USFW_LampControllerComponent*>& USFW_LampRegistrySubsystem::GetLampsInRoom(FName RoomId) const
+{
+	static const TArray<USFW_LampControllerComponent*> Empty;
+	const TArray<USFW_LampControllerComponent*>* Bucket = LampsByRoom.Find(RoomId);
+	return Bucket ? *Bucket : Empty;
+}
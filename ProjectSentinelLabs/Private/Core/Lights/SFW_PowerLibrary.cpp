@@ -2,7 +2,9 @@
 
 #include "Core/Lights/SFW_PowerLibrary.h"
 #include "Core/Components/SFW_LampControllerComponent.h"
+#include "Core/Lights/SFW_LampRegistrySubsystem.h"
 #include "Core/Actors/SFW_EMFDevice.h"
+#include "Core/AnomalySystems/SFW_EMFSourceSubsystem.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "GameFramework/Actor.h"
@@ -23,39 +25,28 @@ bool USFW_PowerLibrary::IsServer(UWorld* World)
 	return World && (World->GetNetMode() != NM_Client);
 }
 
-void USFW_PowerLibrary::ForEachLamp(UWorld* World, TFunctionRef<void(USFW_LampControllerComponent*)> Fn)
+int32 USFW_PowerLibrary::ForEachLamp(UWorld* World, TFunctionRef<void(USFW_LampControllerComponent*)> Fn)
 {
-	if (!World) return;
+	const USFW_LampRegistrySubsystem* Registry = USFW_LampRegistrySubsystem::Get(World);
+	if (!Registry) return 0;
 
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (USFW_LampControllerComponent* L : Registry->GetAllLamps())
 	{
-		AActor* A = *It;
-		if (!A) continue;
-
-		if (USFW_LampControllerComponent* L = A->FindComponentByClass<USFW_LampControllerComponent>())
-		{
-			Fn(L);
-		}
+		if (L) { Fn(L); }
 	}
+	return Registry->GetAllLamps().Num();
 }
 
-void USFW_PowerLibrary::ForEachLampInRoom(UWorld* World, FName RoomId, TFunctionRef<void(USFW_LampControllerComponent*)> Fn)
+int32 USFW_PowerLibrary::ForEachLampInRoom(UWorld* World, FName RoomId, TFunctionRef<void(USFW_LampControllerComponent*)> Fn)
 {
-	if (!World) return;
+	const USFW_LampRegistrySubsystem* Registry = USFW_LampRegistrySubsystem::Get(World);
+	if (!Registry) return 0;
 
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (USFW_LampControllerComponent* L : Registry->GetLampsInRoom(RoomId))
 	{
-		AActor* A = *It;
-		if (!A) continue;
-
-		if (USFW_LampControllerComponent* L = A->FindComponentByClass<USFW_LampControllerComponent>())
-		{
-			if (L->RoomId == RoomId)
-			{
-				Fn(L);
-			}
-		}
+		if (L) { Fn(L); }
 	}
+	return Registry->GetAllLamps().Num();
 }
 
 void USFW_PowerLibrary::BlackoutSite(UObject* WorldContextObject, float Seconds)
@@ -63,10 +54,8 @@ void USFW_PowerLibrary::BlackoutSite(UObject* WorldContextObject, float Seconds)
 	UWorld* W = GetWorldChecked(WorldContextObject);
 	const int bAuth = IsServer(W) ? 1 : 0;
 
-	int32 Total = 0;
-	ForEachLamp(W, [&](USFW_LampControllerComponent* L)
+	const int32 Total = ForEachLamp(W, [&](USFW_LampControllerComponent* L)
 		{
-			++Total;
 			if (bAuth) { L->SetState(ELampState::Off, Seconds); }
 		});
 
@@ -79,15 +68,11 @@ void USFW_PowerLibrary::BlackoutRoom(UObject* WorldContextObject, FName RoomId,
 	UWorld* W = GetWorldChecked(WorldContextObject);
 	const int bAuth = IsServer(W) ? 1 : 0;
 
-	int32 Total = 0, Matched = 0;
-	ForEachLamp(W, [&](USFW_LampControllerComponent* L)
+	int32 Matched = 0;
+	const int32 Total = ForEachLampInRoom(W, RoomId, [&](USFW_LampControllerComponent* L)
 		{
-			++Total;
-			if (L->RoomId == RoomId)
-			{
-				++Matched;
-				if (bAuth) { L->SetState(ELampState::Off, Seconds); }
-			}
+			++Matched;
+			if (bAuth) { L->SetState(ELampState::Off, Seconds); }
 		});
 
 	UE_LOG(LogSFWPower, Log,
@@ -101,15 +86,11 @@ void USFW_PowerLibrary::FlickerRoom(UObject* WorldContextObject, FName RoomId, f
 	UWorld* W = GetWorldChecked(WorldContextObject);
 	const int bAuth = IsServer(W) ? 1 : 0;
 
-	int32 Total = 0, Matched = 0;
-	ForEachLamp(W, [&](USFW_LampControllerComponent* L)
+	int32 Matched = 0;
+	const int32 Total = ForEachLampInRoom(W, RoomId, [&](USFW_LampControllerComponent* L)
 		{
-			++Total;
-			if (L->RoomId == RoomId)
-			{
-				++Matched;
-				if (bAuth) { L->SetState(ELampState::Flicker, Seconds); }
-			}
+			++Matched;
+			if (bAuth) { L->SetState(ELampState::Flicker, Seconds); }
 		});
 
 	UE_LOG(LogSFWPower, Log,
@@ -118,6 +99,20 @@ void USFW_PowerLibrary::FlickerRoom(UObject* WorldContextObject, FName RoomId, f
 	UE_LOG(LogSFWPower, Log, TEXT("[FlickerRoom] TotalLamps=%d Matched=%d"), Total, Matched);
 }
 
+void USFW_PowerLibrary::PlayFlickerRoomLocal(UObject* WorldContextObject, FName RoomId, double StartTime, float Seconds, int32 Seed)
+{
+	UWorld* W = GetWorldChecked(WorldContextObject);
+
+	const int32 Total = ForEachLampInRoom(W, RoomId, [&](USFW_LampControllerComponent* L)
+		{
+			L->PlaySynthesizedFlicker(StartTime, Seconds, Seed);
+		});
+
+	UE_LOG(LogSFWPower, Verbose,
+		TEXT("[PlayFlickerRoomLocal] Room=%s Start=%.2f Sec=%.2f Seed=%d TotalLamps=%d"),
+		*RoomId.ToString(), StartTime, Seconds, Seed, Total);
+}
+
 void USFW_PowerLibrary::TriggerEMFBurst(UObject* WorldContextObject, int32 Level, float Seconds)
 {
 	UWorld* W = GetWorldChecked(WorldContextObject);
@@ -164,37 +159,37 @@ void USFW_PowerLibrary::MakeActorEMFSource(UObject* WorldContextObject, AActor*
 		return;
 	}
 
-	static const FName EMFTag(TEXT("EMF_Source"));
-
-	// Add tag if not already present
-	if (!TargetActor->ActorHasTag(EMFTag))
+	USFW_EMFSourceSubsystem* EMFSources = USFW_EMFSourceSubsystem::Get(W);
+	if (!EMFSources)
 	{
-		TargetActor->Tags.Add(EMFTag);
+		return;
 	}
 
+	// Seconds <= 0 means "leave it on" until something else clears it.
+	// Expiry is handled by the subsystem, no per-call timer needed.
+	EMFSources->RegisterSource(TargetActor, Seconds);
+
 	UE_LOG(LogSFWPower, Log, TEXT("[MakeActorEMFSource] Actor=%s Sec=%.2f"),
 		*TargetActor->GetName(), Seconds);
+}
 
-	// Seconds <= 0 means "leave it on" until something else clears it
-	if (Seconds <= 0.f)
+void USFW_PowerLibrary::ClearActorEMFSource(UObject* WorldContextObject, AActor* TargetActor)
+{
+	if (!TargetActor)
 	{
 		return;
 	}
 
-	TWeakObjectPtr<AActor> WeakTarget = TargetActor;
-
-	FTimerDelegate RemoveDelegate;
-	RemoveDelegate.BindLambda([WeakTarget]()
-		{
-			if (AActor* A = WeakTarget.Get())
-			{
-				static const FName EMFTagInner(TEXT("EMF_Source"));
-				A->Tags.Remove(EMFTagInner);
+	UWorld* W = GetWorldChecked(WorldContextObject);
+	if (!IsServer(W))
+	{
+		return;
+	}
 
-				UE_LOG(LogSFWPower, Log, TEXT("[MakeActorEMFSource] Tag removed from %s"), *A->GetName());
-			}
-		});
+	if (USFW_EMFSourceSubsystem* EMFSources = USFW_EMFSourceSubsystem::Get(W))
+	{
+		EMFSources->UnregisterSource(TargetActor);
 
-	FTimerHandle TmpHandle;
-	W->GetTimerManager().SetTimer(TmpHandle, RemoveDelegate, Seconds, false);
+		UE_LOG(LogSFWPower, Log, TEXT("[ClearActorEMFSource] Actor=%s"), *TargetActor->GetName());
+	}
 }
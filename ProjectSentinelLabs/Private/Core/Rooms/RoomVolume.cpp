@@ -11,7 +11,11 @@
 #include "GameFramework/Controller.h"
 #include "Engine/World.h"
 #include "Components/ShapeComponent.h"
+#include "Components/BoxComponent.h"
 #include "Core/Components/SFW_AnomalyPropComponent.h"
+#include "Core/AnomalySystems/SFW_AnomalyPropRegistrySubsystem.h"
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
 
 ARoomVolume::ARoomVolume()
 {
@@ -56,6 +60,47 @@ void ARoomVolume::BeginPlay()
 
     OnActorBeginOverlap.AddDynamic(this, &ARoomVolume::HandleBeginOverlap);
     OnActorEndOverlap.AddDynamic(this, &ARoomVolume::HandleEndOverlap);
+
+    if (USFW_RoomIndexSubsystem* Index = USFW_RoomIndexSubsystem::Get(this))
+    {
+        Index->RegisterRoom(this);
+    }
+}
+
+void ARoomVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (USFW_RoomIndexSubsystem* Index = USFW_RoomIndexSubsystem::Get(this))
+    {
+        Index->UnregisterRoom(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+bool ARoomVolume::ContainsPoint(const FVector& Location) const
+{
+    if (const UBoxComponent* Box = Cast<UBoxComponent>(GetCollisionComponent()))
+    {
+        const FVector Local = Box->GetComponentTransform().InverseTransformPosition(Location);
+        const FVector Extent = Box->GetUnscaledBoxExtent();
+        return FMath::Abs(Local.X) <= Extent.X
+            && FMath::Abs(Local.Y) <= Extent.Y
+            && FMath::Abs(Local.Z) <= Extent.Z;
+    }
+
+    return GetRoomBounds().IsInsideOrOn(Location);
+}
+
+FBox ARoomVolume::GetRoomBounds() const
+{
+    if (const UPrimitiveComponent* Shape = GetCollisionComponent())
+    {
+        return Shape->Bounds.GetBox();
+    }
+
+    FVector Origin, Extent;
+    GetActorBounds(true, Origin, Extent);
+    return FBox(Origin - Extent, Origin + Extent);
 }
 
 ASFW_GameState* ARoomVolume::GetSFWGameState() const
@@ -95,11 +140,8 @@ ASFW_PlayerState* ARoomVolume::GetSFWPlayerStateFromActor(AActor* Actor) const
 
 bool ARoomVolume::ShouldProcess(AActor* Actor)
 {
-    const float Now = GetWorld()->TimeSeconds;
-    float& LastTime = LastEventTime.FindOrAdd(Actor);
-    if (Now - LastTime < DebounceSeconds) return false;
-    LastTime = Now;
-    return true;
+    USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this);
+    return !Occupancy || Occupancy->ShouldProcessRoomEvent(this, Actor, DebounceSeconds);
 }
 
 void ARoomVolume::NotifyPresenceChanged(APlayerState* PS, bool bEnter) const
@@ -176,9 +218,32 @@ void ARoomVolume::UpdateRiftFlag(APawn* Pawn, bool bEnter)
     PS->SetInRiftRoom(bEnter);
 }
 
+void ARoomVolume::UpdatePropRegistry(AActor* Actor) const
+{
+    if (USFW_AnomalyPropComponent* PropComp = Actor->FindComponentByClass<USFW_AnomalyPropComponent>())
+    {
+        if (USFW_AnomalyPropRegistrySubsystem* PropRegistry = USFW_AnomalyPropRegistrySubsystem::Get(this))
+        {
+            PropRegistry->UpdatePropRoom(PropComp);
+        }
+    }
+}
+
 void ARoomVolume::HandleBeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 {
-    if (!HasAuthority() || !OtherActor || !ShouldProcess(OtherActor))
+    if (!HasAuthority() || !OtherActor)
+    {
+        return;
+    }
+
+    // Occupancy and the prop registry must see every event, so they are fed before the debounce.
+    if (USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this))
+    {
+        Occupancy->NotifyActorEnteredRoom(this, OtherActor);
+    }
+    UpdatePropRegistry(OtherActor);
+
+    if (!ShouldProcess(OtherActor))
     {
         return;
     }
@@ -216,7 +281,18 @@ void ARoomVolume::HandleBeginOverlap(AActor* OverlappedActor, AActor* OtherActor
 
 void ARoomVolume::HandleEndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 {
-    if (!HasAuthority() || !OtherActor || !ShouldProcess(OtherActor))
+    if (!HasAuthority() || !OtherActor)
+    {
+        return;
+    }
+
+    if (USFW_RoomOccupancySubsystem* Occupancy = USFW_RoomOccupancySubsystem::Get(this))
+    {
+        Occupancy->NotifyActorLeftRoom(this, OtherActor);
+    }
+    UpdatePropRegistry(OtherActor);
+
+    if (!ShouldProcess(OtherActor))
     {
         return;
     }
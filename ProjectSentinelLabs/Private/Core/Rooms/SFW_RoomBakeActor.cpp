@@ -0,0 +1,399 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomBakeActor.cpp
+
+#include "Core/Rooms/SFW_RoomBakeActor.h"
+#include "Core/Rooms/RoomVolume.h"
+
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+// ---- FSFWRoomCellGrid ----
+
+int32 FSFWRoomCellGrid::CellIndexAt(const FVector& Location) const
+{
+	if (!IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector Local = (Location - Origin) / CellSize;
+	const int32 X = FMath::FloorToInt32(Local.X);
+	const int32 Y = FMath::FloorToInt32(Local.Y);
+	const int32 Z = FMath::FloorToInt32(Local.Z);
+
+	if (X < 0 || Y < 0 || Z < 0 || X >= Dims.X || Y >= Dims.Y || Z >= Dims.Z)
+	{
+		return INDEX_NONE;
+	}
+
+	return X + Dims.X * (Y + Dims.Y * Z);
+}
+
+FVector FSFWRoomCellGrid::CellCenter(int32 CellIndex) const
+{
+	const int32 X = CellIndex % Dims.X;
+	const int32 Y = (CellIndex / Dims.X) % Dims.Y;
+	const int32 Z = CellIndex / (Dims.X * Dims.Y);
+	return Origin + (FVector(X, Y, Z) + 0.5) * CellSize;
+}
+
+bool FSFWRoomCellGrid::FindRoomId(const FVector& Location, FName& OutRoomId) const
+{
+	const int32 CellIndex = CellIndexAt(Location);
+	if (CellIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutRoomId = GetCellRoomId(CellIndex);
+	return true;
+}
+
+void FSFWRoomCellGrid::BuildInteriorMask(TBitArray<>& OutInterior) const
+{
+	OutInterior.Init(false, IsValid() ? Cells.Num() : 0);
+	if (!IsValid())
+	{
+		return;
+	}
+
+	// Cells on the grid's outer face are never interior
+	for (int32 Z = 1; Z < Dims.Z - 1; ++Z)
+	{
+		for (int32 Y = 1; Y < Dims.Y - 1; ++Y)
+		{
+			for (int32 X = 1; X < Dims.X - 1; ++X)
+			{
+				const int32 Index = X + Dims.X * (Y + Dims.Y * Z);
+				const uint8 Slot = Cells[Index];
+				if (Slot == 0)
+				{
+					continue;
+				}
+
+				bool bInterior = true;
+				for (int32 DZ = -1; DZ <= 1 && bInterior; ++DZ)
+				{
+					for (int32 DY = -1; DY <= 1 && bInterior; ++DY)
+					{
+						for (int32 DX = -1; DX <= 1 && bInterior; ++DX)
+						{
+							bInterior = Cells[(X + DX) + Dims.X * ((Y + DY) + Dims.Y * (Z + DZ))] == Slot;
+						}
+					}
+				}
+				OutInterior[Index] = bInterior;
+			}
+		}
+	}
+}
+
+// ---- ASFW_RoomBakeActor ----
+
+ASFW_RoomBakeActor::ASFW_RoomBakeActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ASFW_RoomBakeActor::BakeRoomGrid()
+{
+	FSFWRoomCellGrid NewGrid;
+	FBakeReport Report;
+	if (!Voxelize(NewGrid, Report))
+	{
+		return;
+	}
+
+	Modify();
+	Grid = MoveTemp(NewGrid);
+
+	LogReport(TEXT("Baked"), Grid, Report);
+}
+
+void ASFW_RoomBakeActor::BakeRoomGraph()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	TArray<const ARoomVolume*> Rooms;
+	for (TActorIterator<ARoomVolume> It(World); It; ++It)
+	{
+		if (!It->RoomId.IsNone())
+		{
+			Rooms.Add(*It);
+		}
+	}
+
+	// Editor worlds have no room index; resolve against the volumes directly, same priority rule.
+	auto ResolveRoomId = [&Rooms](const FVector& Location)
+	{
+		const ARoomVolume* Best = nullptr;
+		for (const ARoomVolume* Room : Rooms)
+		{
+			if (Room->ContainsPoint(Location) && (!Best || Room->Priority > Best->Priority))
+			{
+				Best = Room;
+			}
+		}
+		return Best ? Best->RoomId : NAME_None;
+	};
+
+	FSFWRoomGraph NewGraph;
+	if (!FSFWRoomGraph::Build(World, ResolveRoomId, PortalProbeDistance, NewGraph))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomBake] No room volumes with a RoomId in this level."));
+		return;
+	}
+
+	Modify();
+	RoomGraph = MoveTemp(NewGraph);
+
+	int32 OneSided = 0;
+	for (const FSFWRoomPortal& Portal : RoomGraph.Portals)
+	{
+		OneSided += Portal.RoomB == INDEX_NONE ? 1 : 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[RoomBake] Baked room graph: %d rooms, %d doors (%d lead to no room)."),
+		RoomGraph.RoomIds.Num(), RoomGraph.Portals.Num(), OneSided);
+
+	for (const FName& RoomId : RoomGraph.RoomIds)
+	{
+		TArray<FName> Adjacent;
+		RoomGraph.GetAdjacentRooms(RoomId, Adjacent);
+		if (Adjacent.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[RoomBake] Room '%s' has no door to another room."), *RoomId.ToString());
+		}
+	}
+}
+
+void ASFW_RoomBakeActor::ValidateRoomGrid() const
+{
+	FSFWRoomCellGrid Fresh;
+	FBakeReport Report;
+	if (!Voxelize(Fresh, Report))
+	{
+		return;
+	}
+
+	LogReport(TEXT("Validated"), Fresh, Report);
+
+	if (!Grid.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomBake] %s has no baked grid. Press Bake Room Grid."), *GetName());
+		return;
+	}
+
+	if (Grid.Dims != Fresh.Dims || !Grid.Origin.Equals(Fresh.Origin) || Grid.CellSize != Fresh.CellSize)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomBake] Baked grid is stale: room bounds or cell size changed since the bake."));
+		return;
+	}
+
+	int32 StaleCells = 0;
+	for (int32 i = 0; i < Fresh.Cells.Num(); ++i)
+	{
+		if (Grid.GetCellRoomId(i) != Fresh.GetCellRoomId(i))
+		{
+			++StaleCells;
+		}
+	}
+
+	if (StaleCells > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomBake] Baked grid is stale: %d cells resolve to a different room. Re-bake."), StaleCells);
+	}
+}
+
+bool ASFW_RoomBakeActor::Voxelize(FSFWRoomCellGrid& OutGrid, FBakeReport& OutReport) const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	TArray<const ARoomVolume*> Rooms;
+	FBox Bounds(ForceInit);
+	for (TActorIterator<ARoomVolume> It(World); It; ++It)
+	{
+		if (!It->RoomId.IsNone())
+		{
+			Rooms.Add(*It);
+			Bounds += It->GetRoomBounds();
+		}
+	}
+
+	if (Rooms.Num() == 0 || !Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomBake] No room volumes with a RoomId in this level."));
+		return false;
+	}
+
+	OutGrid.CellSize = FMath::Max(CellSize, 10.f);
+	OutGrid.Origin = Bounds.Min;
+
+	const FVector Size = Bounds.GetSize();
+	OutGrid.Dims = FIntVector(
+		FMath::Max(1, FMath::CeilToInt32(Size.X / OutGrid.CellSize)),
+		FMath::Max(1, FMath::CeilToInt32(Size.Y / OutGrid.CellSize)),
+		FMath::Max(1, FMath::CeilToInt32(Size.Z / OutGrid.CellSize)));
+
+	const int64 TotalCells = int64(OutGrid.Dims.X) * OutGrid.Dims.Y * OutGrid.Dims.Z;
+	if (TotalCells > MaxCells)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[RoomBake] Grid %s at %.0fcm needs %lld cells (max %lld). Raise CellSize."),
+			*OutGrid.Dims.ToString(), OutGrid.CellSize, TotalCells, MaxCells);
+		return false;
+	}
+	const int32 NumCells = int32(TotalCells);
+
+	for (const ARoomVolume* Room : Rooms)
+	{
+		OutGrid.RoomIds.AddUnique(Room->RoomId);
+	}
+
+	if (OutGrid.RoomIds.Num() > MAX_uint8)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[RoomBake] %d distinct RoomIds; the grid supports at most %d."),
+			OutGrid.RoomIds.Num(), MAX_uint8);
+		return false;
+	}
+
+	OutGrid.Cells.SetNumZeroed(NumCells);
+
+	// Bake-time only: winning priority per cell and overlap flags.
+	TArray<int32> CellPriority;
+	CellPriority.SetNumZeroed(NumCells);
+	TBitArray<> Overlap(false, NumCells);
+	TBitArray<> Ambiguous(false, NumCells);
+
+	OutReport.NumRooms = Rooms.Num();
+
+	for (const ARoomVolume* Room : Rooms)
+	{
+		const uint8 Slot = uint8(OutGrid.RoomIds.IndexOfByKey(Room->RoomId) + 1);
+		const FBox RoomBox = Room->GetRoomBounds();
+
+		const FIntVector Min(
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Min.X - OutGrid.Origin.X) / OutGrid.CellSize), 0, OutGrid.Dims.X - 1),
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Min.Y - OutGrid.Origin.Y) / OutGrid.CellSize), 0, OutGrid.Dims.Y - 1),
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Min.Z - OutGrid.Origin.Z) / OutGrid.CellSize), 0, OutGrid.Dims.Z - 1));
+		const FIntVector Max(
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Max.X - OutGrid.Origin.X) / OutGrid.CellSize), 0, OutGrid.Dims.X - 1),
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Max.Y - OutGrid.Origin.Y) / OutGrid.CellSize), 0, OutGrid.Dims.Y - 1),
+			FMath::Clamp(FMath::FloorToInt32((RoomBox.Max.Z - OutGrid.Origin.Z) / OutGrid.CellSize), 0, OutGrid.Dims.Z - 1));
+
+		int32 Claimed = 0;
+		for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					const int32 Index = X + OutGrid.Dims.X * (Y + OutGrid.Dims.Y * Z);
+					if (!Room->ContainsPoint(OutGrid.CellCenter(Index)))
+					{
+						continue;
+					}
+					++Claimed;
+
+					uint8& Cell = OutGrid.Cells[Index];
+					int32& Priority = CellPriority[Index];
+
+					if (Cell == 0)
+					{
+						Cell = Slot;
+						Priority = Room->Priority;
+					}
+					else if (Cell == Slot)
+					{
+						Priority = FMath::Max(Priority, Room->Priority);
+					}
+					else
+					{
+						// Same rule as the runtime index: higher Priority wins.
+						Overlap[Index] = true;
+						if (Room->Priority > Priority)
+						{
+							Cell = Slot;
+							Priority = Room->Priority;
+						}
+						else if (Room->Priority == Priority)
+						{
+							Ambiguous[Index] = true;
+						}
+					}
+				}
+			}
+		}
+
+		if (Claimed == 0)
+		{
+			OutReport.EmptyRooms.Add(Room->RoomId);
+		}
+	}
+
+	// Gaps: empty cells with covered cells on both sides along X or Y (seams between
+	// or inside rooms that a pawn could stand in and resolve to no room).
+	const int32 DX = OutGrid.Dims.X;
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		if (OutGrid.Cells[Index] != 0)
+		{
+			++OutReport.CoveredCells;
+			continue;
+		}
+
+		const int32 X = Index % DX;
+		const int32 Y = (Index / DX) % OutGrid.Dims.Y;
+		const bool bGapX = X > 0 && X < DX - 1 && OutGrid.Cells[Index - 1] && OutGrid.Cells[Index + 1];
+		const bool bGapY = Y > 0 && Y < OutGrid.Dims.Y - 1 && OutGrid.Cells[Index - DX] && OutGrid.Cells[Index + DX];
+		if (bGapX || bGapY)
+		{
+			++OutReport.GapCells;
+		}
+	}
+
+	OutReport.OverlapCells = Overlap.CountSetBits();
+	OutReport.AmbiguousCells = Ambiguous.CountSetBits();
+
+	return true;
+}
+
+void ASFW_RoomBakeActor::LogReport(const TCHAR* What, const FSFWRoomCellGrid& InGrid, const FBakeReport& Report) const
+{
+	UE_LOG(LogTemp, Display,
+		TEXT("[RoomBake] %s %d volumes / %d rooms into %s cells of %.0fcm (%d covered, %.1f KB)"),
+		What, Report.NumRooms, InGrid.RoomIds.Num(), *InGrid.Dims.ToString(), InGrid.CellSize,
+		Report.CoveredCells, InGrid.Cells.Num() / 1024.f);
+
+	if (Report.OverlapCells > 0)
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[RoomBake] %d cells overlap more than one room (%d at equal Priority, resolved arbitrarily)."),
+			Report.OverlapCells, Report.AmbiguousCells);
+	}
+
+	if (Report.GapCells > 0)
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[RoomBake] %d uncovered cells sit between room cells. Close the seams or lower CellSize."),
+			Report.GapCells);
+	}
+
+	for (const FName& RoomId : Report.EmptyRooms)
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("[RoomBake] A volume of room '%s' covers no cell centre. Lower CellSize or enlarge it."),
+			*RoomId.ToString());
+	}
+}
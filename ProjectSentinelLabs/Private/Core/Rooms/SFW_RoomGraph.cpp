@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomGraph.cpp
+
+#include "Core/Rooms/SFW_RoomGraph.h"
+#include "Core/Rooms/RoomVolume.h"
+#include "Core/Actors/SFW_DoorBase.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+bool FSFWRoomGraph::Build(UWorld* World, TFunctionRef<FName(const FVector&)> ResolveRoomId, float ProbeDistance, FSFWRoomGraph& OutGraph)
+{
+	OutGraph = FSFWRoomGraph();
+	if (!World)
+	{
+		return false;
+	}
+
+	for (TActorIterator<ARoomVolume> It(World); It; ++It)
+	{
+		if (!It->RoomId.IsNone())
+		{
+			OutGraph.RoomIds.AddUnique(It->RoomId);
+		}
+	}
+
+	if (OutGraph.RoomIds.Num() == 0)
+	{
+		return false;
+	}
+
+	OutGraph.BuildLookup();
+
+	for (TActorIterator<ASFW_DoorBase> It(World); It; ++It)
+	{
+		ASFW_DoorBase* Door = *It;
+		const FVector Location = Door->GetActorLocation();
+		const FVector Normal = Door->GetActorForwardVector() * ProbeDistance;
+
+		int32 SideA = OutGraph.FindRoomIndex(ResolveRoomId(Location + Normal));
+		int32 SideB = OutGraph.FindRoomIndex(ResolveRoomId(Location - Normal));
+
+		// The door's own RoomID wins over a probe that landed in a wall seam.
+		const int32 Declared = OutGraph.FindRoomIndex(Door->GetRoomID());
+		if (Declared != INDEX_NONE && SideA != Declared && SideB != Declared)
+		{
+			if (SideA == INDEX_NONE)
+			{
+				SideA = Declared;
+			}
+			else
+			{
+				SideB = Declared;
+			}
+		}
+
+		if (SideA == INDEX_NONE)
+		{
+			Swap(SideA, SideB);
+		}
+		if (SideA == SideB)
+		{
+			SideB = INDEX_NONE;
+		}
+		if (SideA == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[RoomGraph] Door %s is not next to any room; skipped."), *Door->GetName());
+			continue;
+		}
+
+		FSFWRoomPortal& Portal = OutGraph.Portals.AddDefaulted_GetRef();
+		Portal.RoomA = SideA;
+		Portal.RoomB = SideB;
+		Portal.Door = Door;
+		Portal.Location = Location;
+	}
+
+	OutGraph.Finalize();
+	return true;
+}
+
+void FSFWRoomGraph::Finalize()
+{
+	BuildLookup();
+
+	const int32 NumRooms = RoomIds.Num();
+	TArray<int32> PortalCount;
+	PortalCount.SetNumZeroed(NumRooms);
+	for (const FSFWRoomPortal& Portal : Portals)
+	{
+		++PortalCount[Portal.RoomA];
+		if (Portal.RoomB != INDEX_NONE)
+		{
+			++PortalCount[Portal.RoomB];
+		}
+	}
+
+	// Group portal indices by room.
+	RoomPortalStart.SetNumUninitialized(NumRooms + 1);
+	RoomPortalStart[0] = 0;
+	for (int32 Room = 0; Room < NumRooms; ++Room)
+	{
+		RoomPortalStart[Room + 1] = RoomPortalStart[Room] + PortalCount[Room];
+	}
+
+	RoomPortals.SetNumUninitialized(RoomPortalStart[NumRooms]);
+	TArray<int32> Cursor(RoomPortalStart.GetData(), NumRooms);
+	for (int32 PortalIndex = 0; PortalIndex < Portals.Num(); ++PortalIndex)
+	{
+		const FSFWRoomPortal& Portal = Portals[PortalIndex];
+		RoomPortals[Cursor[Portal.RoomA]++] = PortalIndex;
+		if (Portal.RoomB != INDEX_NONE)
+		{
+			RoomPortals[Cursor[Portal.RoomB]++] = PortalIndex;
+		}
+	}
+
+	BuildHops();
+}
+
+void FSFWRoomGraph::BuildLookup()
+{
+	IndexById.Reset();
+	IndexById.Reserve(RoomIds.Num());
+	for (int32 i = 0; i < RoomIds.Num(); ++i)
+	{
+		IndexById.Add(RoomIds[i], i);
+	}
+}
+
+void FSFWRoomGraph::BuildHops()
+{
+	const int32 NumRooms = RoomIds.Num();
+	Hops.Init(Unreachable, NumRooms * NumRooms);
+
+	// Breadth-first from every room; the graph is small and this only runs on build.
+	TArray<int32> Queue;
+	Queue.Reserve(NumRooms);
+	for (int32 Source = 0; Source < NumRooms; ++Source)
+	{
+		uint8* Row = Hops.GetData() + Source * NumRooms;
+		Row[Source] = 0;
+
+		Queue.Reset();
+		Queue.Add(Source);
+		for (int32 Head = 0; Head < Queue.Num(); ++Head)
+		{
+			const int32 Room = Queue[Head];
+			if (Row[Room] >= Unreachable - 1)
+			{
+				continue;
+			}
+
+			for (int32 i = RoomPortalStart[Room]; i < RoomPortalStart[Room + 1]; ++i)
+			{
+				const int32 Next = Portals[RoomPortals[i]].GetOtherRoom(Room);
+				if (Next != INDEX_NONE && Row[Next] == Unreachable)
+				{
+					Row[Next] = Row[Room] + 1;
+					Queue.Add(Next);
+				}
+			}
+		}
+	}
+}
+
+int32 FSFWRoomGraph::GetHopDistance(FName FromRoom, FName ToRoom) const
+{
+	const int32 From = FindRoomIndex(FromRoom);
+	const int32 To = FindRoomIndex(ToRoom);
+	if (From == INDEX_NONE || To == INDEX_NONE || !IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	const uint8 Distance = Hops[From * RoomIds.Num() + To];
+	return Distance == Unreachable ? INDEX_NONE : Distance;
+}
+
+void FSFWRoomGraph::GetRoomsWithinHops(TConstArrayView<FName> SourceRooms, int32 MaxHops, TArray<FName>& OutRooms) const
+{
+	if (!IsValid() || MaxHops < 0)
+	{
+		return;
+	}
+	MaxHops = FMath::Min(MaxHops, Unreachable - 1);
+
+	TArray<int32, TInlineAllocator<8>> Sources;
+	for (const FName& RoomId : SourceRooms)
+	{
+		const int32 Index = FindRoomIndex(RoomId);
+		if (Index != INDEX_NONE)
+		{
+			Sources.AddUnique(Index);
+		}
+	}
+
+	const int32 NumRooms = RoomIds.Num();
+	for (int32 Room = 0; Room < NumRooms; ++Room)
+	{
+		for (const int32 Source : Sources)
+		{
+			if (Hops[Source * NumRooms + Room] <= MaxHops)
+			{
+				OutRooms.Add(RoomIds[Room]);
+				break;
+			}
+		}
+	}
+}
+
+void FSFWRoomGraph::GetBoundaryDoors(FName RoomId, TArray<ASFW_DoorBase*>& OutDoors) const
+{
+	const int32 Room = FindRoomIndex(RoomId);
+	if (Room == INDEX_NONE || !IsValid())
+	{
+		return;
+	}
+
+	for (int32 i = RoomPortalStart[Room]; i < RoomPortalStart[Room + 1]; ++i)
+	{
+		ASFW_DoorBase* Door = Portals[RoomPortals[i]].Door;
+		if (::IsValid(Door))
+		{
+			OutDoors.Add(Door);
+		}
+	}
+}
+
+void FSFWRoomGraph::GetAdjacentRooms(FName RoomId, TArray<FName>& OutRooms) const
+{
+	const int32 Room = FindRoomIndex(RoomId);
+	if (Room == INDEX_NONE || !IsValid())
+	{
+		return;
+	}
+
+	for (int32 i = RoomPortalStart[Room]; i < RoomPortalStart[Room + 1]; ++i)
+	{
+		const int32 Other = Portals[RoomPortals[i]].GetOtherRoom(Room);
+		if (Other != INDEX_NONE)
+		{
+			OutRooms.AddUnique(RoomIds[Other]);
+		}
+	}
+}
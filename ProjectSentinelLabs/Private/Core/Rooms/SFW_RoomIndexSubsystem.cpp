@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomIndexSubsystem.cpp
+
+#include "Core/Rooms/SFW_RoomIndexSubsystem.h"
+#include "Core/Rooms/RoomVolume.h"
+#include "Core/Rooms/SFW_RoomBakeActor.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+USFW_RoomIndexSubsystem* USFW_RoomIndexSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_RoomIndexSubsystem>() : nullptr;
+}
+
+bool USFW_RoomIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_RoomIndexSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Level-placed rooms: register now so queries made from other actors'
+	// BeginPlay (GameMode::StartRound, Shade spawn) don't depend on actor order.
+	for (TActorIterator<ARoomVolume> It(&InWorld); It; ++It)
+	{
+		RegisterRoom(*It);
+	}
+
+	for (TActorIterator<ASFW_RoomBakeActor> It(&InWorld); It; ++It)
+	{
+		if (!BakedGrid.IsValid() && It->GetGrid().IsValid())
+		{
+			BakedGrid = *It;
+			It->GetGrid().BuildInteriorMask(GridInterior);
+		}
+		if (!RoomGraph.IsValid() && It->GetRoomGraph().IsValid())
+		{
+			RoomGraph = It->GetRoomGraph();
+			RoomGraph.BuildLookup();
+		}
+	}
+
+	if (!BakedGrid.IsValid() && Rooms.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[RoomIndex] No baked room grid in %s; RoomId lookups use the volume hierarchy."),
+			*InWorld.GetMapName());
+	}
+
+	if (!RoomGraph.IsValid() && Rooms.Num() > 0)
+	{
+		FSFWRoomGraph::Build(&InWorld,
+			[this](const FVector& Location) { return FindRoomIdAtLocation(Location); },
+			RuntimePortalProbeDistance, RoomGraph);
+	}
+}
+
+void USFW_RoomIndexSubsystem::Deinitialize()
+{
+	Rooms.Reset();
+	VolumesById.Reset();
+	BakedGrid.Reset();
+	GridInterior.Empty();
+	RoomGraph = FSFWRoomGraph();
+	Nodes.Reset();
+	ItemOrder.Reset();
+	ItemBounds.Reset();
+	bTreeDirty = true;
+
+	Super::Deinitialize();
+}
+
+void USFW_RoomIndexSubsystem::RegisterRoom(ARoomVolume* Room)
+{
+	if (!Room || Room->RoomId.IsNone() || Rooms.Contains(Room))
+	{
+		return;
+	}
+
+	Rooms.Add(Room);
+	VolumesById.FindOrAdd(Room->RoomId).Add(Room);
+	bTreeDirty = true;
+}
+
+void USFW_RoomIndexSubsystem::UnregisterRoom(ARoomVolume* Room)
+{
+	if (!Room || Rooms.Remove(Room) == 0)
+	{
+		return;
+	}
+
+	if (TArray<ARoomVolume*>* Volumes = VolumesById.Find(Room->RoomId))
+	{
+		Volumes->Remove(Room);
+		if (Volumes->Num() == 0)
+		{
+			VolumesById.Remove(Room->RoomId);
+		}
+	}
+	bTreeDirty = true;
+}
+
+void USFW_RoomIndexSubsystem::RebuildIfDirty() const
+{
+	if (!bTreeDirty)
+	{
+		return;
+	}
+	bTreeDirty = false;
+
+	Nodes.Reset();
+	ItemOrder.Reset();
+	ItemBounds.Reset();
+
+	const int32 Num = Rooms.Num();
+	if (Num == 0)
+	{
+		return;
+	}
+
+	ItemBounds.Reserve(Num);
+	ItemOrder.Reserve(Num);
+	for (int32 i = 0; i < Num; ++i)
+	{
+		ItemBounds.Add(Rooms[i]->GetRoomBounds());
+		ItemOrder.Add(i);
+	}
+
+	Nodes.Reserve(2 * Num);
+	BuildNode(0, Num);
+}
+
+int32 USFW_RoomIndexSubsystem::BuildNode(int32 Begin, int32 End) const
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+
+	FBox Bounds(ForceInit);
+	FBox CentroidBounds(ForceInit);
+	for (int32 i = Begin; i < End; ++i)
+	{
+		const FBox& B = ItemBounds[ItemOrder[i]];
+		Bounds += B;
+		CentroidBounds += B.GetCenter();
+	}
+	Nodes[NodeIndex].Bounds = Bounds;
+
+	const int32 Count = End - Begin;
+	if (Count <= MaxLeafItems)
+	{
+		Nodes[NodeIndex].FirstItem = Begin;
+		Nodes[NodeIndex].NumItems = Count;
+		return NodeIndex;
+	}
+
+	// Median split along the longest centroid axis.
+	const FVector Size = CentroidBounds.GetSize();
+	const int32 Axis = (Size.X >= Size.Y && Size.X >= Size.Z) ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+
+	TArrayView<int32> Range(ItemOrder.GetData() + Begin, Count);
+	Range.Sort([this, Axis](int32 A, int32 B)
+	{
+		return ItemBounds[A].GetCenter()[Axis] < ItemBounds[B].GetCenter()[Axis];
+	});
+
+	const int32 Mid = Begin + Count / 2;
+	const int32 Left = BuildNode(Begin, Mid);
+	const int32 Right = BuildNode(Mid, End);
+
+	// Nodes may have reallocated during recursion; index again.
+	Nodes[NodeIndex].Left = Left;
+	Nodes[NodeIndex].Right = Right;
+	return NodeIndex;
+}
+
+ARoomVolume* USFW_RoomIndexSubsystem::FindRoomAtLocation(const FVector& Location) const
+{
+	RebuildIfDirty();
+	if (Nodes.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	ARoomVolume* Best = nullptr;
+
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(0);
+	while (Stack.Num() > 0)
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!Node.Bounds.IsInsideOrOn(Location))
+		{
+			continue;
+		}
+
+		if (!Node.IsLeaf())
+		{
+			Stack.Add(Node.Left);
+			Stack.Add(Node.Right);
+			continue;
+		}
+
+		for (int32 i = Node.FirstItem; i < Node.FirstItem + Node.NumItems; ++i)
+		{
+			const int32 Item = ItemOrder[i];
+			ARoomVolume* Room = Rooms[Item];
+			if (!Room || !ItemBounds[Item].IsInsideOrOn(Location) || !Room->ContainsPoint(Location))
+			{
+				continue;
+			}
+
+			if (!Best || Room->Priority > Best->Priority)
+			{
+				Best = Room;
+			}
+		}
+	}
+
+	return Best;
+}
+
+FName USFW_RoomIndexSubsystem::FindRoomIdAtLocation(const FVector& Location) const
+{
+	if (const ASFW_RoomBakeActor* Bake = BakedGrid.Get())
+	{
+		const FSFWRoomCellGrid& Grid = Bake->GetGrid();
+		const int32 Cell = Grid.CellIndexAt(Location);
+		if (Cell != INDEX_NONE && GridInterior.IsValidIndex(Cell) && GridInterior[Cell])
+		{
+			return Grid.GetCellRoomId(Cell);
+		}
+	}
+
+	const ARoomVolume* Room = FindRoomAtLocation(Location);
+	return Room ? Room->RoomId : NAME_None;
+}
+
+const TArray<ARoomVolume*>& USFW_RoomIndexSubsystem::GetVolumesForRoomId(FName RoomId) const
+{
+	static const TArray<ARoomVolume*> Empty;
+	const TArray<ARoomVolume*>* Volumes = VolumesById.Find(RoomId);
+	return Volumes ? *Volumes : Empty;
+}
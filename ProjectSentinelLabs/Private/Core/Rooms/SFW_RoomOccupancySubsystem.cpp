@@ -0,0 +1,317 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomOccupancySubsystem.cpp
+
+#include "Core/Rooms/SFW_RoomOccupancySubsystem.h"
+#include "Core/Rooms/RoomVolume.h"
+#include "Core/Game/SFW_PlayerState.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+	int32 SanityTierToInt(ESanityTier T)
+	{
+		switch (T)
+		{
+		case ESanityTier::T1: return 1;
+		case ESanityTier::T2: return 2;
+		case ESanityTier::T3: return 3;
+		default:              return 1;
+		}
+	}
+}
+
+USFW_RoomOccupancySubsystem* USFW_RoomOccupancySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_RoomOccupancySubsystem>() : nullptr;
+}
+
+bool USFW_RoomOccupancySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_RoomOccupancySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// A pawn that starts inside a room unpossessed only becomes a "player" once
+	// a controller takes it; re-evaluate its rooms when that happens.
+	if (UGameInstance* GI = InWorld.GetGameInstance())
+	{
+		GI->OnPawnControllerChangedDelegates.AddDynamic(this, &USFW_RoomOccupancySubsystem::HandlePawnControllerChanged);
+	}
+}
+
+void USFW_RoomOccupancySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UGameInstance* GI = World->GetGameInstance())
+		{
+			GI->OnPawnControllerChangedDelegates.RemoveDynamic(this, &USFW_RoomOccupancySubsystem::HandlePawnControllerChanged);
+		}
+	}
+
+	Rooms.Reset();
+	PawnRooms.Reset();
+	OccupiedRooms.Reset();
+	LastEventTime.Reset();
+
+	Super::Deinitialize();
+}
+
+void USFW_RoomOccupancySubsystem::NotifyActorEnteredRoom(const ARoomVolume* Room, AActor* Actor)
+{
+	APawn* Pawn = Cast<APawn>(Actor);
+	if (!Room || !Pawn || Room->RoomId.IsNone())
+	{
+		return;
+	}
+
+	FRoomEntry& Entry = Rooms.FindOrAdd(Room->RoomId);
+	FPawnOverlap& Overlap = Entry.Pawns.FindOrAdd(Pawn);
+	if (Overlap.Volumes++ == 0)
+	{
+		PawnRooms.FindOrAdd(Pawn).AddUnique(Room->RoomId);
+	}
+	if (!Room->bIsSafeRoom)
+	{
+		++Overlap.TargetableVolumes;
+	}
+
+	RefreshRoom(Room->RoomId);
+}
+
+void USFW_RoomOccupancySubsystem::NotifyActorLeftRoom(const ARoomVolume* Room, AActor* Actor)
+{
+	APawn* Pawn = Cast<APawn>(Actor);
+	if (!Room || !Pawn || Room->RoomId.IsNone())
+	{
+		return;
+	}
+
+	FRoomEntry* Entry = Rooms.Find(Room->RoomId);
+	FPawnOverlap* Overlap = Entry ? Entry->Pawns.Find(Pawn) : nullptr;
+	if (!Overlap)
+	{
+		return;
+	}
+
+	if (!Room->bIsSafeRoom)
+	{
+		Overlap->TargetableVolumes = FMath::Max(0, Overlap->TargetableVolumes - 1);
+	}
+	if (--Overlap->Volumes <= 0)
+	{
+		Entry->Pawns.Remove(Pawn);
+
+		if (TArray<FName, TInlineAllocator<2>>* PawnRoomIds = PawnRooms.Find(Pawn))
+		{
+			PawnRoomIds->Remove(Room->RoomId);
+			if (PawnRoomIds->Num() == 0)
+			{
+				PawnRooms.Remove(Pawn);
+			}
+		}
+	}
+
+	RefreshRoom(Room->RoomId);
+}
+
+void USFW_RoomOccupancySubsystem::NotifySanityTierChanged(const ASFW_PlayerState* PlayerState)
+{
+	if (PlayerState)
+	{
+		RefreshRoomsForPawn(PlayerState->GetPawn());
+	}
+}
+
+void USFW_RoomOccupancySubsystem::HandlePawnControllerChanged(APawn* Pawn, AController* Controller)
+{
+	RefreshRoomsForPawn(Pawn);
+}
+
+void USFW_RoomOccupancySubsystem::RefreshRoomsForPawn(const APawn* Pawn)
+{
+	if (!Pawn)
+	{
+		return;
+	}
+
+	if (const TArray<FName, TInlineAllocator<2>>* PawnRoomIds = PawnRooms.Find(Pawn))
+	{
+		for (const FName RoomId : *PawnRoomIds)
+		{
+			RefreshRoom(RoomId);
+		}
+	}
+}
+
+void USFW_RoomOccupancySubsystem::RefreshRoom(FName RoomId)
+{
+	FRoomEntry* Entry = Rooms.Find(RoomId);
+	if (!Entry)
+	{
+		return;
+	}
+
+	int32 NumPlayers = 0;
+	int32 MaxTier = 1;
+	bool bTargetable = false;
+
+	for (auto It = Entry->Pawns.CreateIterator(); It; ++It)
+	{
+		const APawn* Pawn = It.Key().Get();
+		if (!Pawn)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		if (!Pawn->IsPlayerControlled())
+		{
+			continue;
+		}
+
+		++NumPlayers;
+		bTargetable |= (It.Value().TargetableVolumes > 0);
+
+		if (const ASFW_PlayerState* PS = Pawn->GetPlayerState<ASFW_PlayerState>())
+		{
+			MaxTier = FMath::Max(MaxTier, SanityTierToInt(PS->GetSanityTier()));
+		}
+	}
+
+	const bool bChanged = NumPlayers != Entry->NumPlayers || MaxTier != Entry->MaxTier || bTargetable != Entry->bTargetable;
+
+	Entry->NumPlayers = NumPlayers;
+	Entry->MaxTier = MaxTier;
+
+	if (bTargetable != Entry->bTargetable)
+	{
+		Entry->bTargetable = bTargetable;
+		if (bTargetable)
+		{
+			OccupiedRooms.Add(RoomId);
+		}
+		else
+		{
+			OccupiedRooms.RemoveSingle(RoomId);
+		}
+	}
+
+	if (bChanged)
+	{
+		OnOccupancyChanged.Broadcast(RoomId);
+	}
+}
+
+int32 USFW_RoomOccupancySubsystem::GetRoomTier(FName RoomId) const
+{
+	const FRoomEntry* Entry = Rooms.Find(RoomId);
+	return Entry ? Entry->MaxTier : 1;
+}
+
+int32 USFW_RoomOccupancySubsystem::GetNumPlayersInRoom(FName RoomId) const
+{
+	const FRoomEntry* Entry = Rooms.Find(RoomId);
+	return Entry ? Entry->NumPlayers : 0;
+}
+
+void USFW_RoomOccupancySubsystem::GetRoomsWithPlayers(TArray<FName>& OutRooms) const
+{
+	for (const TPair<FName, FRoomEntry>& Pair : Rooms)
+	{
+		if (Pair.Value.NumPlayers > 0)
+		{
+			OutRooms.Add(Pair.Key);
+		}
+	}
+}
+
+void USFW_RoomOccupancySubsystem::GetPlayerPawnsInRoom(FName RoomId, TArray<APawn*>& OutPawns) const
+{
+	const FRoomEntry* Entry = Rooms.Find(RoomId);
+	if (!Entry || Entry->NumPlayers == 0)
+	{
+		return;
+	}
+
+	for (const TPair<TWeakObjectPtr<APawn>, FPawnOverlap>& Pair : Entry->Pawns)
+	{
+		APawn* Pawn = Pair.Key.Get();
+		if (Pawn && Pawn->IsPlayerControlled())
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+void USFW_RoomOccupancySubsystem::GetPlayerPawnsOutsideRooms(TArray<APawn*>& OutPawns) const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+		if (Pawn && !PawnRooms.Contains(Pawn))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+bool USFW_RoomOccupancySubsystem::ShouldProcessRoomEvent(const ARoomVolume* Room, const AActor* Actor, float DebounceSeconds)
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return true;
+	}
+
+	const double Now = World->GetTimeSeconds();
+	MaxDebounceSeconds = FMath::Max(MaxDebounceSeconds, DebounceSeconds);
+
+	const FDebounceKey Key(Room, Actor);
+	if (const double* LastTime = LastEventTime.Find(Key))
+	{
+		if (Now - *LastTime < DebounceSeconds)
+		{
+			return false;
+		}
+	}
+	else if (LastEventTime.Num() >= DebouncePruneThreshold)
+	{
+		PruneDebounce(Now);
+	}
+
+	LastEventTime.Add(Key, Now);
+	return true;
+}
+
+void USFW_RoomOccupancySubsystem::PruneDebounce(double Now)
+{
+	for (auto It = LastEventTime.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().Key.IsValid() || !It.Key().Value.IsValid() || Now - It.Value() >= MaxDebounceSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Mostly live entries: raise the bar so we don't prune on every insert.
+	if (LastEventTime.Num() * 2 >= DebouncePruneThreshold)
+	{
+		DebouncePruneThreshold *= 2;
+	}
+}
@@ -0,0 +1,262 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomPathCacheSubsystem.cpp
+
+#include "Core/Rooms/SFW_RoomPathCacheSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "NavigationSystem.h"
+#include "NavMesh/NavMeshPath.h"
+
+USFW_RoomPathCacheSubsystem* USFW_RoomPathCacheSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_RoomPathCacheSubsystem>() : nullptr;
+}
+
+bool USFW_RoomPathCacheSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_RoomPathCacheSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(
+			this, &USFW_RoomPathCacheSubsystem::OnNavigationGenerationFinished);
+	}
+}
+
+void USFW_RoomPathCacheSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(
+			this, &USFW_RoomPathCacheSubsystem::OnNavigationGenerationFinished);
+
+		for (const TPair<uint32, FPendingQuery>& Pending : PendingQueries)
+		{
+			NavSys->AbortAsyncFindPathRequest(Pending.Key);
+		}
+	}
+
+	Corridors.Reset();
+	Anchors.Reset();
+	PendingQueries.Reset();
+	RecentInvalidations.Reset();
+
+	Super::Deinitialize();
+}
+
+bool USFW_RoomPathCacheSubsystem::GetRoomAnchor(FName RoomId, const FVector& Hint, FVector& OutAnchor)
+{
+	if (const FVector* Cached = RoomId.IsNone() ? nullptr : Anchors.Find(RoomId))
+	{
+		OutAnchor = *Cached;
+		return true;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	// Box extent gives us some room to find nearby nav
+	FNavLocation Projected;
+	if (!NavSys->ProjectPointToNavigation(Hint, Projected, FVector(500.f, 500.f, 500.f)))
+	{
+		return false;
+	}
+
+	OutAnchor = Projected.Location;
+	if (!RoomId.IsNone())
+	{
+		Anchors.Add(RoomId, OutAnchor);
+	}
+	return true;
+}
+
+uint32 USFW_RoomPathCacheSubsystem::RequestPath(const APawn* Querier, FName FromRoomId, FName ToRoomId,
+	const FVector& Start, const FVector& Anchor, FSFWOnRoomPathReady Callback)
+{
+	const bool bCacheable = !FromRoomId.IsNone() && !ToRoomId.IsNone();
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = (NavSys && Querier) ? NavSys->GetNavDataForProps(Querier->GetNavAgentPropertiesRef()) : nullptr;
+	if (!NavData)
+	{
+		Callback.ExecuteIfBound(nullptr);
+		return 0;
+	}
+
+	if (const TArray<FNavPathPoint>* Corridor = bCacheable ? Corridors.Find(MakeTuple(FromRoomId, ToRoomId)) : nullptr)
+	{
+		if (FNavPathSharedPtr Path = JoinCorridor(*Corridor, Querier, *NavData, Start))
+		{
+			Callback.ExecuteIfBound(Path);
+			return 0;
+		}
+	}
+
+	FPathFindingQuery Query(Querier, *NavData, Start, Anchor);
+	const uint32 QueryId = NavSys->FindPathAsync(Querier->GetNavAgentPropertiesRef(), Query,
+		FNavPathQueryDelegate::CreateUObject(this, &USFW_RoomPathCacheSubsystem::OnPathQueryFinished));
+
+	if (QueryId == INVALID_NAVQUERYID)
+	{
+		Callback.ExecuteIfBound(nullptr);
+		return 0;
+	}
+
+	FPendingQuery& Pending = PendingQueries.Add(QueryId);
+	Pending.FromRoomId = bCacheable ? FromRoomId : NAME_None;
+	Pending.ToRoomId = ToRoomId;
+	Pending.Generation = Generation;
+	Pending.Callback = MoveTemp(Callback);
+	return QueryId;
+}
+
+void USFW_RoomPathCacheSubsystem::CancelRequest(uint32 QueryId)
+{
+	if (PendingQueries.Remove(QueryId) == 0)
+	{
+		return;
+	}
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->AbortAsyncFindPathRequest(QueryId);
+	}
+}
+
+void USFW_RoomPathCacheSubsystem::InvalidateAll()
+{
+	FullInvalidationGeneration = ++Generation;
+	RecentInvalidations.Reset();
+	Corridors.Reset();
+}
+
+void USFW_RoomPathCacheSubsystem::InvalidateNear(const FVector& Location, float Radius)
+{
+	const double RadiusSq = FMath::Square(static_cast<double>(Radius));
+
+	// Only in-flight queries whose result passes here are affected (see OnPathQueryFinished)
+	if (PendingQueries.Num() > 0)
+	{
+		RecentInvalidations.Add({ Location, RadiusSq, ++Generation });
+	}
+
+	for (auto It = Corridors.CreateIterator(); It; ++It)
+	{
+		if (PassesNear(It.Value(), Location, RadiusSq))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool USFW_RoomPathCacheSubsystem::PassesNear(TConstArrayView<FNavPathPoint> Points, const FVector& Location, double RadiusSq)
+{
+	for (int32 i = 1; i < Points.Num(); ++i)
+	{
+		if (FMath::PointDistToSegmentSquared(Location, Points[i - 1].Location, Points[i].Location) <= RadiusSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FNavPathSharedPtr USFW_RoomPathCacheSubsystem::JoinCorridor(const TArray<FNavPathPoint>& Corridor, const APawn* Querier,
+	const ANavigationData& NavData, const FVector& Start) const
+{
+	UWorld* World = GetWorld();
+	if (Corridor.Num() < 2)
+	{
+		return nullptr;
+	}
+
+	// Furthest reachable point first, so the joined path skips as much of the corridor's start as possible
+	for (int32 Join = FMath::Min(Corridor.Num(), MaxJoinProbes) - 1; Join >= 0; --Join)
+	{
+		FVector HitLocation;
+		if (UNavigationSystemV1::NavigationRaycast(World, Start, Corridor[Join].Location, HitLocation, nullptr, Querier->GetController()))
+		{
+			continue;
+		}
+
+		// Created by the nav data with the querier's query, like a FindPathAsync result, so
+		// it is an active path: nav changes (door lock areas) invalidate and re-plan it
+		FNavPathSharedPtr Path = NavData.CreatePathInstance<FNavMeshPath>(
+			FPathFindingQuery(Querier, NavData, Start, Corridor.Last().Location));
+
+		// Points are copied whole: their flags / custom link ids make path following
+		// hand the agent to door links (ASFW_DoorBase::OnNavLinkReached)
+		TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+		Points.Reserve(Corridor.Num() - Join + 1);
+		Points.Add(FNavPathPoint(Start));
+		Points.Append(&Corridor[Join], Corridor.Num() - Join);
+
+		Path->MarkReady();
+		return Path;
+	}
+
+	return nullptr;
+}
+
+void USFW_RoomPathCacheSubsystem::OnPathQueryFinished(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FPendingQuery Pending;
+	if (!PendingQueries.RemoveAndCopyValue(QueryId, Pending))
+	{
+		return; // cancelled
+	}
+
+	const bool bFound = Result == ENavigationQueryResult::Success && Path.IsValid();
+
+	// Partial paths are still worth following, but only complete ones become corridors
+	bool bCache = bFound && !Path->IsPartial() && !Pending.FromRoomId.IsNone()
+		&& Pending.Generation >= FullInvalidationGeneration;
+
+	// Doors that changed while this query ran only matter if the result passes them
+	for (const FNearInvalidation& Change : RecentInvalidations)
+	{
+		if (!bCache)
+		{
+			break;
+		}
+		if (Change.Generation > Pending.Generation)
+		{
+			bCache = !PassesNear(Path->GetPathPoints(), Change.Location, Change.RadiusSq);
+		}
+	}
+
+	if (bCache)
+	{
+		Corridors.Add(MakeTuple(Pending.FromRoomId, Pending.ToRoomId), Path->GetPathPoints());
+	}
+
+	// Keep only the changes some remaining query started before
+	uint32 OldestPending = Generation;
+	for (const TPair<uint32, FPendingQuery>& Other : PendingQueries)
+	{
+		OldestPending = FMath::Min(OldestPending, Other.Value.Generation);
+	}
+	RecentInvalidations.RemoveAll([OldestPending](const FNearInvalidation& Change)
+	{
+		return Change.Generation <= OldestPending;
+	});
+
+	Pending.Callback.ExecuteIfBound(bFound ? Path : nullptr);
+}
+
+void USFW_RoomPathCacheSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	InvalidateAll();
+	Anchors.Reset();
+}
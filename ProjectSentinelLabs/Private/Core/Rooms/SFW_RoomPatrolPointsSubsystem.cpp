@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomPatrolPointsSubsystem.cpp
+
+#include "Core/Rooms/SFW_RoomPatrolPointsSubsystem.h"
+#include "Core/Rooms/RoomVolume.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/Crc.h"
+#include "NavigationSystem.h"
+
+USFW_RoomPatrolPointsSubsystem* USFW_RoomPatrolPointsSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<USFW_RoomPatrolPointsSubsystem>() : nullptr;
+}
+
+bool USFW_RoomPatrolPointsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USFW_RoomPatrolPointsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld);
+	if (!NavSys)
+	{
+		return;
+	}
+
+	if (NavSys->GetDefaultNavDataInstance() && !NavSys->IsNavigationBuildInProgress() && BakeAllRooms())
+	{
+		return;
+	}
+
+	// A navmesh still building (or not loaded yet) bakes once it finishes instead
+	NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(
+		this, &USFW_RoomPatrolPointsSubsystem::OnNavigationGenerationFinished);
+}
+
+void USFW_RoomPatrolPointsSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(
+			this, &USFW_RoomPatrolPointsSubsystem::OnNavigationGenerationFinished);
+	}
+
+	Points.Reset();
+	RoomSpans.Reset();
+
+	Super::Deinitialize();
+}
+
+TConstArrayView<FVector> USFW_RoomPatrolPointsSubsystem::GetPatrolPoints(FName RoomId) const
+{
+	const FRoomSpan* Span = RoomId.IsNone() ? nullptr : RoomSpans.Find(RoomId);
+	return Span ? TConstArrayView<FVector>(Points.GetData() + Span->First, Span->Num) : TConstArrayView<FVector>();
+}
+
+bool USFW_RoomPatrolPointsSubsystem::BakeAllRooms()
+{
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	if (!NavData)
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Points.Reset();
+	RoomSpans.Reset();
+
+	// Volumes are walked directly: the room index may not have registered them yet.
+	TArray<const ARoomVolume*> Volumes;
+	TMap<FName, FBox> RoomBounds;
+	for (TActorIterator<ARoomVolume> It(World); It; ++It)
+	{
+		if (!It->RoomId.IsNone())
+		{
+			Volumes.Add(*It);
+			RoomBounds.FindOrAdd(It->RoomId, FBox(ForceInit)) += It->GetRoomBounds();
+		}
+	}
+
+	// Same priority rule as the room index
+	auto ResolveRoomId = [&Volumes](const FVector& Location)
+	{
+		const ARoomVolume* Best = nullptr;
+		for (const ARoomVolume* Room : Volumes)
+		{
+			if (Room->ContainsPoint(Location) && (!Best || Room->Priority > Best->Priority))
+			{
+				Best = Room;
+			}
+		}
+		return Best ? Best->RoomId : NAME_None;
+	};
+
+	const float Step = MinPointSpacing * 0.5f;
+	const double MinSpacingSq = FMath::Square(static_cast<double>(MinPointSpacing));
+	int32 EmptyRooms = 0;
+
+	for (const TPair<FName, FBox>& Room : RoomBounds)
+	{
+		const FName RoomId = Room.Key;
+		const FBox& Bounds = Room.Value;
+
+		// Stable per room, unlike GetTypeHash(FName)
+		FRandomStream Stream(static_cast<int32>(FCrc::StrCrc32(*RoomId.ToString())));
+
+		// Jittered grid candidates on the navmesh, inside this room
+		const FVector Extent(Step * 0.5f, Step * 0.5f, Bounds.GetExtent().Z + 100.f);
+		TArray<FVector> Candidates;
+		for (float X = Bounds.Min.X; X < Bounds.Max.X; X += Step)
+		{
+			for (float Y = Bounds.Min.Y; Y < Bounds.Max.Y; Y += Step)
+			{
+				const FVector Sample(X + Stream.FRandRange(0.f, Step), Y + Stream.FRandRange(0.f, Step), Bounds.GetCenter().Z);
+
+				FNavLocation Projected;
+				if (NavSys->ProjectPointToNavigation(Sample, Projected, Extent, NavData)
+					&& ResolveRoomId(Projected.Location + FVector(0.f, 0.f, MembershipProbeHeight)) == RoomId)
+				{
+					Candidates.Add(Projected.Location);
+				}
+			}
+		}
+
+		if (Candidates.Num() == 0)
+		{
+			++EmptyRooms;
+			continue;
+		}
+
+		// Reachability is judged from the in-room candidate nearest the centre; a
+		// projection of the centre itself can land in the next room
+		const FVector Center = Bounds.GetCenter();
+		FVector Anchor = Candidates[0];
+		for (const FVector& Candidate : Candidates)
+		{
+			if (FVector::DistSquared2D(Candidate, Center) < FVector::DistSquared2D(Anchor, Center))
+			{
+				Anchor = Candidate;
+			}
+		}
+
+		// Dart throwing over the shuffled candidates gives the Poisson-disk spacing
+		for (int32 i = Candidates.Num() - 1; i > 0; --i)
+		{
+			Candidates.Swap(i, Stream.RandRange(0, i));
+		}
+
+		const int32 First = Points.Num();
+		for (const FVector& Candidate : Candidates)
+		{
+			if (Points.Num() - First >= MaxPointsPerRoom)
+			{
+				break;
+			}
+
+			bool bTooClose = false;
+			for (int32 i = First; i < Points.Num() && !bTooClose; ++i)
+			{
+				bTooClose = FVector::DistSquared(Points[i], Candidate) < MinSpacingSq;
+			}
+			if (bTooClose)
+			{
+				continue;
+			}
+
+			// Drops furniture islands and pockets sealed off from the rest of the room
+			if (!NavSys->TestPathSync(FPathFindingQuery(this, *NavData, Anchor, Candidate)))
+			{
+				continue;
+			}
+
+			Points.Add(Candidate);
+		}
+
+		if (Points.Num() > First)
+		{
+			RoomSpans.Add(RoomId, FRoomSpan{ First, Points.Num() - First });
+		}
+		else
+		{
+			++EmptyRooms;
+		}
+	}
+
+	Points.Shrink();
+
+	UE_LOG(LogTemp, Log, TEXT("[RoomPatrol] Baked %d patrol points for %d rooms in %.1f ms."),
+		Points.Num(), RoomSpans.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	if (EmptyRooms > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[RoomPatrol] %d rooms have no reachable navmesh points; patrols there fall back to random nav queries."),
+			EmptyRooms);
+	}
+
+	return RoomSpans.Num() > 0;
+}
+
+void USFW_RoomPatrolPointsSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	// Later rebuilds (streaming, dynamic obstacles) keep the first good bake
+	if (BakeAllRooms())
+	{
+		if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(
+				this, &USFW_RoomPatrolPointsSubsystem::OnNavigationGenerationFinished);
+		}
+	}
+}
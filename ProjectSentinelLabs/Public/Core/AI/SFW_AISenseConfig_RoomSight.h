@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AISenseConfig_RoomSight.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Perception/AISenseConfig.h"
+#include "Core/AI/SFW_AISense_RoomSight.h"
+#include "SFW_AISenseConfig_RoomSight.generated.h"
+
+/** Per-listener settings for USFW_AISense_RoomSight. */
+UCLASS(meta = (DisplayName = "SFW Room Sight config"))
+class PROJECTSENTINELLABS_API USFW_AISenseConfig_RoomSight : public UAISenseConfig
+{
+	GENERATED_BODY()
+
+public:
+	USFW_AISenseConfig_RoomSight(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual TSubclassOf<UAISense> GetSenseImplementation() const override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Sense", NoClear, config)
+	TSubclassOf<USFW_AISense_RoomSight> Implementation;
+
+	/** Distance at which a player can be first seen. */
+	UPROPERTY(EditDefaultsOnly, Category = "Sense", meta = (UIMin = 0.0, ClampMin = 0.0))
+	float SightRadius = 1500.f;
+
+	/** Distance beyond which a seen player is lost. Should be >= SightRadius. */
+	UPROPERTY(EditDefaultsOnly, Category = "Sense", meta = (UIMin = 0.0, ClampMin = 0.0))
+	float LoseSightRadius = 1800.f;
+
+	/** Half angle of the view cone, in degrees. */
+	UPROPERTY(EditDefaultsOnly, Category = "Sense", meta = (UIMin = 0.0, ClampMin = 0.0, UIMax = 180.0, ClampMax = 180.0))
+	float PeripheralVisionAngleDegrees = 60.f;
+
+	/** Only players at most this many doors from the listener's room are considered. */
+	UPROPERTY(EditDefaultsOnly, Category = "Sense", meta = (UIMin = 0, ClampMin = 0))
+	int32 MaxRoomHops = 1;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AISense_RoomSight.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Perception/AISense.h"
+#include "WorldCollision.h"
+#include "SFW_AISense_RoomSight.generated.h"
+
+class USFW_AISenseConfig_RoomSight;
+
+/**
+ * Sight that only looks at players the room ledger says are nearby.
+ *
+ * Each update a listener considers the players in rooms
+ * (USFW_RoomOccupancySubsystem) at most MaxRoomHops doors from its own room,
+ * instead of every pawn in the world. Distance and view cone are checked first;
+ * survivors queue a line-of-sight check. The queue is shared by all listeners and
+ * drained at MaxTracesPerTick async traces per update, so the cost per frame stays
+ * flat however many players and Shades there are. A target is re-checked once its
+ * previous trace has returned.
+ *
+ * Players in rooms more than MaxRoomHops doors away are the only ones culled; players
+ * in no room volume are checked against radius and cone alone, like the stock sight.
+ *
+ * Seen is reported on every trace that gets through, so a target in view keeps a
+ * fresh stimulus (listeners' max age still applies). Lost is reported once, when a
+ * trace is blocked or the target leaves radius, cone or candidate rooms.
+ */
+UCLASS(ClassGroup = AI)
+class PROJECTSENTINELLABS_API USFW_AISense_RoomSight : public UAISense
+{
+	GENERATED_BODY()
+
+public:
+	USFW_AISense_RoomSight(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Line-of-sight traces started per update, across all listeners. */
+	UPROPERTY(config)
+	int32 MaxTracesPerTick = 6;
+
+protected:
+	virtual float Update() override;
+
+	void OnNewListenerImpl(const FPerceptionListener& NewListener);
+	void OnListenerUpdateImpl(const FPerceptionListener& UpdatedListener);
+	void OnListenerRemovedImpl(const FPerceptionListener& RemovedListener);
+
+private:
+	struct FTargetState
+	{
+		bool bVisible = false;
+		/** Queued or tracing; not queued again until the result is in. */
+		bool bPending = false;
+		/** Bumped when the target stops being a candidate; older trace results are ignored. */
+		uint32 Generation = 0;
+	};
+
+	struct FListenerState
+	{
+		float SightRadiusSq = 0.f;
+		float LoseSightRadiusSq = 0.f;
+		float CosHalfAngle = 0.f;
+		int32 MaxRoomHops = 0;
+
+		TMap<TWeakObjectPtr<AActor>, FTargetState> Targets;
+	};
+
+	struct FSightCheck
+	{
+		FPerceptionListenerID ListenerId;
+		TWeakObjectPtr<AActor> Target;
+		uint32 Generation = 0;
+	};
+
+	static void DigestConfig(const USFW_AISenseConfig_RoomSight& Config, FListenerState& OutState);
+
+	/** Radius (Lose radius while seen) and view cone. */
+	static bool IsInSightVolume(const FListenerState& State, const FPerceptionListener& Listener, const AActor& Target, bool bCurrentlyVisible);
+
+	void GatherCandidates(const FPerceptionListener& Listener, const FListenerState& State, TArray<APawn*>& OutCandidates) const;
+	void IssueTraces();
+	void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+	void ReportTarget(const FPerceptionListenerID& ListenerId, FTargetState& TargetState, AActor& Target, bool bVisible);
+
+	TMap<FPerceptionListenerID, FListenerState> ListenerStates;
+
+	/** Waiting for trace budget, oldest first. */
+	TArray<FSightCheck> CheckQueue;
+
+	/** Traces in flight, keyed by the ticket passed as trace UserData. */
+	TMap<uint32, FSightCheck> InFlight;
+	uint32 NextTicket = 0;
+
+	FTraceDelegate TraceDelegate;
+};
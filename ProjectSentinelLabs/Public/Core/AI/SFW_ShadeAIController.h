@@ -5,10 +5,11 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "Perception/AIPerceptionTypes.h"
+#include "NavigationData.h"
 #include "SFW_ShadeAIController.generated.h"
 
 class UAIPerceptionComponent;
-class UAISenseConfig_Sight;
+class USFW_AISenseConfig_RoomSight;
 class ARoomVolume;
 class ASFW_ShadeCharacterBase;
 struct FPathFollowingResult;
@@ -23,10 +24,16 @@ public:
 
 	// AAIController
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
 
-	// Simple controller-side state (no BT)
+	/**
+	 * Simple controller-side state (no BT). Event driven: transitions come from
+	 * perception, path-following results, the Shade's room changes and timers.
+	 * The controller doesn't tick; a state that needs polling gets a timer at its
+	 * own rate (GetStateUpdateInterval), and actor tick is only on while Chase
+	 * has a focus to turn towards.
+	 */
 	enum class EShadeAIState : uint8
 	{
 		TravelToRift,
@@ -39,13 +46,32 @@ protected:
 	/** === State & Transitions === */
 	EShadeAIState AIState = EShadeAIState::Patrol;
 
+	/** Switch state and re-arm the per-state update timer. Enter* helpers go through this. */
+	void SetAIState(EShadeAIState NewState);
+
+	/** Seconds between UpdateState calls while in State; 0 = no polling. */
+	float GetStateUpdateInterval(EShadeAIState State) const;
+
+	/** Periodic work for states that poll: target tracking (Chase). */
+	void UpdateState();
+
+	FTimerHandle StateUpdateHandle;
+
+	/** Room changes drive transitions too (entering the Rift room ends TravelToRift). */
+	void OnShadeRoomChanged(FName PrevRoomId, FName NewRoomId);
+
+	/** Arrival at the Rift, by path-following success or by entering the Rift room. */
+	void OnReachedRift();
+
 	// Early-game behavior – ignore players completely
 	UPROPERTY(EditAnywhere, Category = "AI|Behavior")
 	bool bIgnorePlayers = true;
 
-	// Debug: draw Shade position + Rift target
+	// Debug: draw Shade position + Rift target (compiled out where debug drawing is, e.g. Shipping)
 	UPROPERTY(EditAnywhere, Category = "AI|Debug")
-	bool bDebugDrawPath = true;
+	bool bDebugDrawPath = false;
+
+	FTimerHandle DebugDrawHandle;
 
 	void DebugDrawShade() const;
 
@@ -69,8 +95,9 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI|Perception")
 	UAIPerceptionComponent* Perception = nullptr;
 
+	// Room-culled, trace-budgeted sight (USFW_AISense_RoomSight)
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI|Perception")
-	UAISenseConfig_Sight* SightConfig = nullptr;
+	USFW_AISenseConfig_RoomSight* SightConfig = nullptr;
 
 	UFUNCTION()
 	void OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus);
@@ -96,30 +123,30 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Travel")
 	float TravelAcceptanceRadius = 200.f;
 
-	// Travel retry handling
+	// Travel retry handling: TravelRetryDelay doubles per consecutive failure, up to MaxTravelRetryDelay
 	FTimerHandle TravelRetryHandle;
 
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Travel")
 	float TravelRetryDelay = 1.0f;
 
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Travel")
-	int32 MaxTravelRetries = 8;
+	float MaxTravelRetryDelay = 16.0f;
 
-	int32 TravelRetryCount = 0;
-
-	// Door probe while traveling
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Travel")
-	float DoorProbeDistance = 150.f;
+	int32 MaxTravelRetries = 8;
 
-	UPROPERTY(EditDefaultsOnly, Category = "AI|Travel")
-	float DoorCheckInterval = 0.5f;
+	int32 TravelRetryCount = 0;
 
-	double NextDoorCheckTime = 0.0;
+	// Pending async path query (USFW_RoomPathCacheSubsystem), 0 when none
+	uint32 TravelPathQueryId = 0;
 
-	void TryResolveDoorBlockage();
+	void OnTravelPathReady(FNavPathSharedPtr Path);
+	void ScheduleTravelRetry();
+	void CancelTravelPathQuery();
 
 	/** === Patrol === */
-	// How far from the center the Shade can wander while patrolling
+	// Patrol destinations come from the room's baked set (USFW_RoomPatrolPointsSubsystem).
+	// How far from the center the Shade can wander when the room has none
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Patrol")
 	float PatrolRadius = 800.f;
 
@@ -134,6 +161,9 @@ protected:
 
 	// Debounce: ensure only one patrol leg runs at a time
 	bool bPatrolLegActive = false;
+
+	// Room and point index of the current leg, so the next leg picks a different point
+	FName PatrolRoomId = NAME_None;
 	int32 CurrentGoalIndex = INDEX_NONE;
 
 	void StartPatrol();
@@ -152,6 +182,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
 	float AttackDistance = 120.f;
 
+	// Update rate while chasing (last known position + attack range)
+	UPROPERTY(EditDefaultsOnly, Category = "AI|Combat")
+	float ChaseUpdateInterval = 0.1f;
+
 	// Proximity check stub (wired later)
 	void TryAttackTarget();
 };
@@ -10,6 +10,8 @@ class USphereComponent;
 class APawn;
 class ARoomVolume;
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FSFWOnShadeRoomChanged, FName /*PrevRoomId*/, FName /*NewRoomId*/);
+
 UENUM(BlueprintType)
 enum class EShadeState : uint8
 {
@@ -28,6 +30,7 @@ public:
     ASFW_ShadeCharacterBase();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
     /** 0..1 global aggression factor (can be fed from GameState / anomaly). */
@@ -72,6 +75,9 @@ public:
     UFUNCTION(BlueprintPure, Category = "Shade|AI")
     FName GetCurrentRoomId() const { return CurrentRoomId; }
 
+    /** Server-only: fired when CurrentRoomId changes. */
+    FSFWOnShadeRoomChanged OnRoomChanged;
+
 protected:
     // --- Movement tuning ---
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
@@ -18,6 +18,9 @@ class USoundBase;
 class ASFW_AnomalyDecisionSystem;
 class ASFW_DoorScareFX;
 class ASFW_ShadeCharacterBase;
+class UNavLinkCustomComponent;
+class UNavModifierComponent;
+class UNavArea;
 
 UENUM(BlueprintType)
 enum class EDoorState : uint8
@@ -91,6 +94,45 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "SFW|Door|Interact")
 	FVector InteractionBoxOffset = FVector(10, 0, 95);
 
+	// Navigation: the doorway is cut out of the navmesh (DoorwayNavModifier) and bridged
+	// by a smart link, so AI paths cross it only through NavLink. Reaching the link opens
+	// the door; while locked the link takes LockedNavArea and pathing goes around.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SFW|Door|Nav")
+	UNavLinkCustomComponent* NavLink = nullptr;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SFW|Door|Nav")
+	UNavModifierComponent* DoorwayNavModifier = nullptr;
+
+	/**
+	 * Fit DoorwayNavExtent and the link ends to the Door mesh in its closed pose on
+	 * construction. Off: the values below are used as set (and only checked).
+	 */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav")
+	bool bFitNavToDoor = true;
+
+	/** Smallest half depth of the cutout across the doorway (local X); a thin leaf alone leaves no gap in the navmesh. */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav", meta = (ClampMin = "0.0", EditCondition = "bFitNavToDoor"))
+	float DoorwayNavMinDepth = 40.f;
+
+	/** How far past the cutout each link end sits; should exceed the agent radius so the ends land on navmesh. */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav", meta = (ClampMin = "0.0", EditCondition = "bFitNavToDoor"))
+	float NavLinkClearance = 60.f;
+
+	/** Link ends, relative to the door; one on each side of the doorway. */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav", meta = (EditCondition = "!bFitNavToDoor"))
+	FVector NavLinkStart = FVector(-100, 0, 0);
+
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav", meta = (EditCondition = "!bFitNavToDoor"))
+	FVector NavLinkEnd = FVector(100, 0, 0);
+
+	/** Half size of the box cut out of the navmesh, around the door's origin. */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav", meta = (EditCondition = "!bFitNavToDoor"))
+	FVector DoorwayNavExtent = FVector(40, 60, 110);
+
+	/** Link area while locked: NavArea_Null blocks it, a high-cost area only discourages it. */
+	UPROPERTY(EditAnywhere, Category = "SFW|Door|Nav")
+	TSubclassOf<UNavArea> LockedNavArea;
+
 	// Initial/random state
 	UPROPERTY(EditAnywhere, Category = "SFW|Door|Initial") EDoorState InitialState = EDoorState::Closed;
 	UPROPERTY(EditAnywhere, Category = "SFW|Door|Initial") bool bRandomizeInitialState = false;
@@ -124,6 +166,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "SFW|Scare") float ScareCooldown = 10.0f;
 
 	FTimerHandle Timer_SlamImpact;
+	FTimerHandle Timer_LockExpired;
+
+	// Path-following agents that reached NavLink while locked; resumed on unlock
+	TArray<TWeakObjectPtr<UObject>> LinkAgentsWaiting;
 
 	// Motion state
 	float StartYaw = 0.f, TargetYaw = 0.f, AnimT = 0.f;
@@ -138,6 +184,16 @@ protected:
 	// New: adjust collision while animating so Shade can pass through
 	void SetDoorCollisionForAnimation(bool bAnimating);
 
+	// Server: drop Shade path corridors through this door after a state / lock change
+	void InvalidateCachedPaths() const;
+
+	// Construction: size the cutout and link ends from the closed leaf, then sanity-check them
+	void FitDoorwayNav();
+
+	// Server: link area follows the lock; re-arms itself until LockEndTime passes
+	void RefreshNavLinkState();
+	void OnNavLinkReached(UNavLinkCustomComponent* Link, UObject* PathComp, const FVector& DestPoint);
+
 	void TryDoorScare(APawn* ApproachingPawn, bool bForce = false);
 	void StartSlamSequence(APawn* ApproachingPawn);
 	void OnSlamImpact();
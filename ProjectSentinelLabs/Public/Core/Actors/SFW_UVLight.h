@@ -12,6 +12,7 @@ class USpotLightComponent;
 class USoundBase;
 class UTextureLightProfile;
 class UPrimitiveComponent;
+class ASFW_SigilSystem;
 
 /** Handheld UV light. */
 UCLASS()
@@ -98,6 +99,9 @@ protected:
 
 	FTimerHandle ScanTimer;
 
+	/** Sigil system from the anomaly registry; its cone query only indexes the active layout. */
+	ASFW_SigilSystem* ResolveSigilSystem() const;
+
 	// SFX
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UVLight|SFX")
 	TObjectPtr<USoundBase> ToggleOnSFX = nullptr;
@@ -5,19 +5,23 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Engine/DataTable.h"
+#include "Tasks/Task.h"
 #include "Core/AnomalySystems/SFW_DecisionTypes.h"
+#include "Core/AnomalySystems/SFW_DecisionSelector.h"
+#include "Core/AnomalySystems/SFW_DecisionNetBundle.h"
 #include "SFW_AnomalyDecisionSystem.generated.h"
 
 class ARoomVolume;
 class ASFW_PlayerState;
 class ASFW_AnomalyController;
+class USFW_CompiledDecisionTables;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FSFWOnDecision, const FSFWDecisionPayload&);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSFWOnDecisionBP, const FSFWDecisionPayload&, Payload);
 
 /**
  * Single source of truth for anomaly decisions.
- * - Reads FSFWDecisionRow from a DataTable.
+ * - Reads decision rows from USFW_CompiledDecisionTables (or FSFWDecisionRow DataTables).
  * - Chooses room based on player occupancy / sanity tier.
  * - Broadcasts FSFWDecisionPayload to C++ and BP listeners.
  */
@@ -35,16 +39,75 @@ public:
 	/** Fired on server only, for C++ listeners (doors, etc). */
 	FSFWOnDecision OnDecision;
 
-	/** Replicated via MulticastDecision to clients, for BP listeners (lamps, FX, etc). */
+	/** Replicated to clients (MulticastDecision, or a cosmetic bundle), for BP listeners (lamps, FX, etc). */
 	UPROPERTY(BlueprintAssignable, Category = "Anomaly")
 	FSFWOnDecisionBP OnDecisionBP;
 
+	// ---- Targeted routing ----
+	// Handlers only run for decisions of Type dispatched to RoomId (NAME_None = any room),
+	// so Dispatch cost scales with the affected subscribers instead of every door / lamp.
+	// Don't subscribe from inside a routed handler.
+
+	/** Server only, alongside OnDecision. */
+	FDelegateHandle SubscribeToDecision(FName RoomId, ESFWDecision Type, const FSFWOnDecision::FDelegate& Handler);
+
+	/** Every machine, from MulticastDecision, alongside OnDecisionBP. */
+	FDelegateHandle SubscribeToDecisionMulticast(FName RoomId, ESFWDecision Type, const FSFWOnDecision::FDelegate& Handler);
+
+	/** Remove every routed handler bound to UserObject (both tables). */
+	void UnsubscribeFromDecisions(const void* UserObject);
+
+	/**
+	 * Something that may let a decision fire has changed (occupancy, Shade room,
+	 * pacing): re-evaluate as soon as IntervalSec pacing allows. Server only.
+	 */
+	void WakeDecisions();
+
+	// ---- Anomaly agents (server) ----
+	// ActiveAnomalyType and each of AdditionalAnomalyTypes run as an agent with its own
+	// profile bias, cooldowns and IntervalSec pacing. All agents share one timer and
+	// DecisionBudgetMicros. Don't add or remove agents from inside a decision handler.
+
+	/** Start deciding for AnomalyType as well (no-op if it already has an agent). */
+	void AddAnomalyAgent(ESFWAnomalyType AnomalyType);
+
+	/** Stop AnomalyType's agent. The ActiveAnomalyType agent stays. */
+	void RemoveAnomalyAgent(ESFWAnomalyType AnomalyType);
+
+	int32 GetNumAnomalyAgents() const { return Agents.Num(); }
+
+	// ---- Cooldowns (server) ----
+
+	/** Seconds until ActiveAnomalyType's decisions of Type may fire again, 0 if ready. */
+	UFUNCTION(BlueprintPure, Category = "Anomaly")
+	float GetCooldownRemaining(ESFWDecision Type) const;
+
+	/** World time the earliest running cooldown of any agent ends, or TNumericLimits<double>::Max() if none. */
+	double GetNextCooldownExpiry();
+
+	/** ActiveAnomalyType's cooldowns. */
+	const FSFWDecisionCooldowns& GetCooldowns() const;
+
+	/**
+	 * Decisions whose client side is effects only; anything they change on the
+	 * server (lamp mode, prop physics) replicates on its own. These may be batched
+	 * and sent unreliably.
+	 */
+	static bool IsCosmeticDecision(ESFWDecision Type);
+
 protected:
-	/** DataTable of FSFWDecisionRow. This is the brains config. */
+	/**
+	 * Decisions and profiles compiled from DataTables. When set and compiled, DecisionsDT and
+	 * AnomalyProfilesDT are ignored.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly")
+	TObjectPtr<USFW_CompiledDecisionTables> CompiledTables = nullptr;
+
+	/** DataTable of FSFWDecisionRow. Used when CompiledTables isn't set. This is the brains config. */
 	UPROPERTY(EditAnywhere, Category = "Anomaly")
 	UDataTable* DecisionsDT = nullptr;
 
-	/** Profiles for Binder / Watcher / etc (FSFWAnomalyProfileRow). */
+	/** Profiles for Binder / Watcher / etc (FSFWAnomalyProfileRow). Used when CompiledTables isn't set. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Anomaly")
 	UDataTable* AnomalyProfilesDT = nullptr;
 
@@ -52,37 +115,160 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Anomaly")
 	ESFWAnomalyType ActiveAnomalyType = ESFWAnomalyType::Binder;
 
-	/** How often to attempt a decision, in seconds (server only). */
+	/** Further anomalies active at the same time, each deciding on its own (server). */
+	UPROPERTY(EditAnywhere, Category = "Anomaly")
+	TArray<ESFWAnomalyType> AdditionalAnomalyTypes;
+
+	/**
+	 * Wall-clock microseconds of decision evaluation per frame, shared by every agent.
+	 * At least one due agent runs per frame; the rest wait for the next frame, most
+	 * overdue first, so cost stays flat as agents are added and none starves.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly", meta = (ClampMin = "0"))
+	float DecisionBudgetMicros = 250.f;
+
+	/**
+	 * Snapshot the world on the game thread, pick the target room and decision on a
+	 * worker task, and dispatch the result on the game thread the next frame.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly")
+	bool bEvaluateAsync = false;
+
+	/**
+	 * Minimum seconds between decisions (server only). Between decisions the system
+	 * sleeps until a cooldown expires or occupancy / the Shade's room changes.
+	 */
 	UPROPERTY(EditAnywhere, Category = "Anomaly")
 	float IntervalSec = 2.0f;
 
+	/**
+	 * Without a Shade room, decisions target rooms up to this many doors from an
+	 * occupied room (0 = occupied rooms only). Safe rooms are never targeted.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly", meta = (ClampMin = "0"))
+	int32 TargetHopsFromPlayers = 0;
+
+	/**
+	 * Send cosmetic decisions (see IsCosmeticDecision) to clients as one unreliable
+	 * bundle per frame instead of one reliable multicast each, so bursts of
+	 * flickers and knocks can't back up the reliable channel.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly|Replication")
+	bool bBatchCosmeticDecisions = false;
+
+	/**
+	 * LampFlicker replicates only the decision record (room, start time, seed);
+	 * every machine regenerates the per-lamp pattern locally instead of the server
+	 * replicating each lamp's state. Costs a few bytes however many lamps the room has.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Anomaly|Replication")
+	bool bSynthesizeLampEffects = false;
+
+	/** Cosmetic payloads dispatched this frame, sent by FlushCosmeticDecisions (server). */
+	FSFWDecisionBundle PendingCosmetic;
+
 	FTimerHandle TickHandle;
 
-	/** Per-decision-type cooldown: ESFWDecision -> next allowed world time. */
-	TMap<ESFWDecision, double> NextAllowedTime;
+	/** World time TickHandle fires, or TNumericLimits<double>::Max() while asleep. */
+	double ScheduledWakeTime = TNumericLimits<double>::Max();
+
+	static constexpr float MinWakeDelaySec = 0.05f;
+
+	/** One concurrently active anomaly (server). */
+	struct FAnomalyAgent
+	{
+		ESFWAnomalyType AnomalyType = ESFWAnomalyType::None;
+
+		/** Decision rows compiled with this agent's profile bias, plus its cooldowns. */
+		FSFWDecisionSelector Selector;
+
+		// Cached behavior bias from the agent's profile
+		float DoorBias = 1.f;
+		float LightBias = 1.f;
+
+		/** World time this agent wants evaluating, or TNumericLimits<double>::Max() while asleep. */
+		double WakeTime = TNumericLimits<double>::Max();
+
+		/** World time of this agent's last dispatched decision (pacing). */
+		double LastDecisionTime = -TNumericLimits<double>::Max();
+
+		/** In-flight worker evaluation (bEvaluateAsync); the agent sleeps until it is applied. */
+		UE::Tasks::TTask<FSFWDecisionResult> PendingEvaluation;
+	};
+
+	/** Agents[0] is ActiveAnomalyType once play has begun. */
+	TArray<FAnomalyAgent> Agents;
+
+	/** Set while TickDecision walks Agents. */
+	bool bEvaluatingAgents = false;
+
+	/** DecisionsDT read once into plain rows, when there is no CompiledTables (server). */
+	TArray<FSFWDecisionRowView> TableRows;
+
+	/** Runs ApplyAsyncResults on the frame after a worker evaluation starts. */
+	FTimerHandle ApplyHandle;
 
-	// Cached behavior bias from the active profile
-	float CachedDoorBias = 1.f;
-	float CachedLightBias = 1.f;
+	/** Safe rooms of the room graph, gathered on first use (rooms don't change during play). */
+	TArray<FName> SafeRoomIds;
+	bool bSafeRoomIdsGathered = false;
+
+	/** (RoomId, Type) -> handlers. RoomId NAME_None is the any-room wildcard. */
+	using FSFWDecisionRouteKey = TPair<FName, ESFWDecision>;
+	TMap<FSFWDecisionRouteKey, FSFWOnDecision> ServerRoutes;
+	TMap<FSFWDecisionRouteKey, FSFWOnDecision> MulticastRoutes;
+
+	static void BroadcastRoutes(const TMap<FSFWDecisionRouteKey, FSFWOnDecision>& Routes, const FSFWDecisionPayload& Payload);
 
 	// Link to the round controller (for Shade decisions, etc.)
 	UPROPERTY()
 	ASFW_AnomalyController* AnomalyController = nullptr;
 
 	// Core loop
+	/** Evaluate due agents, most overdue first, until DecisionBudgetMicros is spent; then re-arm the timer. */
 	UFUNCTION()
 	void TickDecision();
 
+	/** Try one decision for Agent; returns its next world time worth trying, or TNumericLimits<double>::Max() to sleep. */
+	double TryDecide(FAnomalyAgent& Agent);
+
+	/** Snapshot occupancy, tiers and the Shade's room for one evaluation. */
+	void BuildDecisionInput(FSFWDecisionInput& OutInput);
+
+	/** Start the cooldown and dispatch a decided Result; returns the agent's next wake time. */
+	double ApplyDecision(FAnomalyAgent& Agent, const FSFWDecisionResult& Result);
+
+	/** Apply finished worker evaluations; keeps polling each frame while any are running. */
+	void ApplyAsyncResults();
+
+	/** Make sure Agent is evaluated no later than WakeTime (subject to its IntervalSec pacing). */
+	void ScheduleAgentAt(FAnomalyAgent& Agent, double WakeTime);
+
+	/** Make sure TickDecision runs no later than WakeTime. */
+	void ScheduleDecisionAt(double WakeTime);
+
 	// Helpers
-	bool IsReady(const FSFWDecisionRow& R) const;
-	void StartCooldown(const FSFWDecisionRow& R);
-	const FSFWDecisionRow* PickWeighted(int32 Tier);
-	void Dispatch(const FSFWDecisionRow& R, FName RoomId);
+	bool HasCompiledTables() const;
+	FAnomalyAgent* FindAgent(ESFWAnomalyType AnomalyType);
+	const FSFWDecisionRowView* PickWeighted(FAnomalyAgent& Agent, int32 Tier);
+	bool EnsureSamplerCompiled(FAnomalyAgent& Agent);
+	void HandleDecisionsTableChanged();
+	void Dispatch(const FSFWDecisionRowView& R, FName RoomId, ESFWAnomalyType AnomalyType);
 	int32 GetRoomTier(FName RoomId) const;
-	void RefreshBiasFromProfile();
-	void HandlePropPulse(const FSFWDecisionRow& R, FName RoomId);
+	void RefreshBiasFromProfile(FAnomalyAgent& Agent) const;
+	void HandlePropPulse(const FSFWDecisionRowView& R, FName RoomId);
+
+	/** Queue a cosmetic payload for this frame's bundle; local listeners run right away. */
+	void QueueCosmeticDecision(const FSFWDecisionPayload& Payload);
+	void FlushCosmeticDecisions();
 
-	/** Multicast payload to all clients, then raise OnDecisionBP. */
+	/** Routed multicast subscribers, then OnDecisionBP. */
+	void BroadcastToMulticastListeners(const FSFWDecisionPayload& Payload);
+
+	/** Multicast payload to all clients, then raise OnDecisionBP. Gameplay-relevant decisions. */
 	UFUNCTION(NetMulticast, Reliable)
 	void MulticastDecision(const FSFWDecisionPayload& Payload);
+
+	/** One frame's cosmetic decisions. May be dropped; the server already raised its own listeners. */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastCosmeticDecisions(const FSFWDecisionBundle& Bundle);
 };
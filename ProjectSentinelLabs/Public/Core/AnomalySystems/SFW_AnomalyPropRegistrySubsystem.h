@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AnomalyPropRegistrySubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_AnomalyPropRegistrySubsystem.generated.h"
+
+class USFW_AnomalyPropComponent;
+
+/**
+ * Server-side registry of anomaly props, bucketed by RoomId.
+ *
+ * Props register on BeginPlay / EndPlay and get a stable index (freed slots are
+ * reused). Their room is resolved through USFW_RoomIndexSubsystem on registration
+ * and again whenever ARoomVolume sees the prop cross a room boundary, so decision
+ * handlers can pick props in a room without scanning every component in memory.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_AnomalyPropRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_AnomalyPropRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	void RegisterProp(USFW_AnomalyPropComponent* Prop);
+	void UnregisterProp(USFW_AnomalyPropComponent* Prop);
+
+	/** Re-resolve Prop's room from its owner's location and move it between buckets if needed. */
+	void UpdatePropRoom(USFW_AnomalyPropComponent* Prop);
+
+	/** RoomId Prop is currently filed under, or NAME_None. */
+	FName GetPropRoom(const USFW_AnomalyPropComponent* Prop) const;
+
+	int32 GetNumPropsInRoom(FName RoomId) const;
+
+	/**
+	 * Append up to Count distinct random props in RoomId to OutProps. Partial
+	 * Fisher-Yates over the room bucket, so the cost is O(Count) regardless of
+	 * how many props the room holds. Returns the number appended.
+	 */
+	int32 SamplePropsInRoom(FName RoomId, int32 Count, TArray<USFW_AnomalyPropComponent*>& OutProps);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FPropEntry
+	{
+		TWeakObjectPtr<USFW_AnomalyPropComponent> Prop;
+		FName RoomId;
+		/** Position of this entry inside its room bucket (for O(1) removal). */
+		int32 SlotInRoom = INDEX_NONE;
+	};
+
+	void AddToRoom(int32 PropIndex, FName RoomId);
+	void RemoveFromRoom(int32 PropIndex);
+
+	/** Stable prop storage; freed slots are reused. */
+	TSparseArray<FPropEntry> Props;
+
+	/** Component -> index into Props. */
+	TMap<TWeakObjectPtr<const USFW_AnomalyPropComponent>, int32> IndexByProp;
+
+	/** RoomId -> indices into Props. Unordered; sampling shuffles it in place. */
+	TMap<FName, TArray<int32>> PropsByRoom;
+};
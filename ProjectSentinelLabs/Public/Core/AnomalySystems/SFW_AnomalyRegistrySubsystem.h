@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_AnomalyRegistrySubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_AnomalyRegistrySubsystem.generated.h"
+
+class ASFW_AnomalyDecisionSystem;
+class ASFW_SigilSystem;
+class ASFW_ShadeCharacterBase;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FSFWOnDecisionSystemReady, ASFW_AnomalyDecisionSystem*);
+DECLARE_MULTICAST_DELEGATE_OneParam(FSFWOnSigilSystemReady, ASFW_SigilSystem*);
+DECLARE_MULTICAST_DELEGATE_OneParam(FSFWOnShadeReady, ASFW_ShadeCharacterBase*);
+
+/**
+ * Lookup point for the per-world anomaly singletons (decision system, sigil system, Shade).
+ *
+ * Providers register on BeginPlay / EndPlay. Consumers either read the pointer or,
+ * if they may start first, use the When*Ready calls: the callback runs immediately
+ * when the provider is already registered, otherwise once it registers.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_AnomalyRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_AnomalyRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	// ---- Decision system ----
+	void RegisterDecisionSystem(ASFW_AnomalyDecisionSystem* System);
+	void UnregisterDecisionSystem(ASFW_AnomalyDecisionSystem* System);
+	ASFW_AnomalyDecisionSystem* GetDecisionSystem() const { return DecisionSystem.Get(); }
+	void WhenDecisionSystemReady(FSFWOnDecisionSystemReady::FDelegate&& Callback);
+
+	// ---- Sigil system ----
+	void RegisterSigilSystem(ASFW_SigilSystem* System);
+	void UnregisterSigilSystem(ASFW_SigilSystem* System);
+	ASFW_SigilSystem* GetSigilSystem() const { return SigilSystem.Get(); }
+	void WhenSigilSystemReady(FSFWOnSigilSystemReady::FDelegate&& Callback);
+
+	// ---- Shade (one active at a time) ----
+	void RegisterShade(ASFW_ShadeCharacterBase* Shade);
+	void UnregisterShade(ASFW_ShadeCharacterBase* Shade);
+	ASFW_ShadeCharacterBase* GetActiveShade() const { return ActiveShade.Get(); }
+	void WhenShadeReady(FSFWOnShadeReady::FDelegate&& Callback);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TWeakObjectPtr<ASFW_AnomalyDecisionSystem> DecisionSystem;
+	TWeakObjectPtr<ASFW_SigilSystem> SigilSystem;
+	TWeakObjectPtr<ASFW_ShadeCharacterBase> ActiveShade;
+
+	// One-shot callbacks waiting for a provider.
+	FSFWOnDecisionSystemReady PendingDecisionSystem;
+	FSFWOnSigilSystemReady PendingSigilSystem;
+	FSFWOnShadeReady PendingShade;
+};
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_CompiledDecisionTables.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Core/AnomalySystems/SFW_DecisionTypes.h"
+#include "SFW_CompiledDecisionTables.generated.h"
+
+class UDataTable;
+
+/** Plain copy of the FSFWDecisionRow fields the decision system reads at runtime. */
+struct FSFWDecisionRowView
+{
+	int32 Tier = 1;
+	ESFWDecision Type = ESFWDecision::Idle;
+	float Weight = 1.f;
+	float CooldownSec = 6.f;
+	float Magnitude = 1.f;
+	float Duration = 2.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FSFWDecisionRowView& Row)
+	{
+		return Ar << Row.Tier << Row.Type << Row.Weight << Row.CooldownSec << Row.Magnitude << Row.Duration;
+	}
+};
+
+/** Plain copy of the FSFWAnomalyProfileRow fields the decision system reads at runtime. */
+struct FSFWAnomalyProfileView
+{
+	float DoorBias = 1.f;
+	float LightBias = 1.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FSFWAnomalyProfileView& Profile)
+	{
+		return Ar << Profile.DoorBias << Profile.LightBias;
+	}
+};
+
+/**
+ * DecisionsDT and AnomalyProfilesDT flattened for runtime.
+ *
+ * Compile (button, or automatically on save) copies the source tables into
+ * contiguous arrays: decision rows sorted by tier then type, and one profile per
+ * ESFWAnomalyType value. The arrays are saved as a versioned binary blob; the
+ * source tables are editor-only references and are not cooked through this asset.
+ * Nothing walks a row map or touches UScriptStruct while a round is running.
+ *
+ * A blob saved with a different FormatVersion loads empty (IsCompiled() false) and
+ * needs recompiling; ASFW_AnomalyDecisionSystem falls back to its DataTables then.
+ */
+UCLASS(BlueprintType)
+class PROJECTSENTINELLABS_API USFW_CompiledDecisionTables : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Bump when FSFWDecisionRowView / FSFWAnomalyProfileView or the blob layout changes. */
+	static constexpr int32 FormatVersion = 1;
+
+	static constexpr int32 NumAnomalyTypes = static_cast<int32>(ESFWAnomalyType::MAX);
+
+	// PrimaryAssetId type = "DecisionTables"
+	virtual FPrimaryAssetId GetPrimaryAssetId() const override
+	{
+		return FPrimaryAssetId(TEXT("DecisionTables"), GetFName());
+	}
+
+	virtual void Serialize(FArchive& Ar) override;
+
+#if WITH_EDITORONLY_DATA
+	/** DataTable of FSFWDecisionRow. */
+	UPROPERTY(EditAnywhere, Category = "Source")
+	TObjectPtr<UDataTable> DecisionsSource = nullptr;
+
+	/** DataTable of FSFWAnomalyProfileRow. */
+	UPROPERTY(EditAnywhere, Category = "Source")
+	TObjectPtr<UDataTable> ProfilesSource = nullptr;
+#endif
+
+#if WITH_EDITOR
+	/** Rebuild the runtime arrays from the source tables. */
+	UFUNCTION(CallInEditor, Category = "Source")
+	void Compile();
+
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+#endif
+
+	bool IsCompiled() const { return bCompiled; }
+
+	/** Every weighted decision row, sorted by tier then type. */
+	TConstArrayView<FSFWDecisionRowView> GetDecisionRows() const { return DecisionRows; }
+
+	/** Profile for AnomalyType (neutral bias if the source had no row for it). */
+	const FSFWAnomalyProfileView& GetProfile(ESFWAnomalyType AnomalyType) const;
+
+	/** Copy Table's FSFWDecisionRow rows with positive weight, sorted by tier then type. */
+	static void ReadDecisionRows(const UDataTable* Table, TArray<FSFWDecisionRowView>& OutRows);
+
+	/** Copy Table's FSFWAnomalyProfileRow rows, indexed by ESFWAnomalyType. The first row per type wins. */
+	static void ReadProfiles(const UDataTable* Table, TArray<FSFWAnomalyProfileView>& OutProfiles);
+
+private:
+	TArray<FSFWDecisionRowView> DecisionRows;
+	TArray<FSFWAnomalyProfileView> Profiles;
+	bool bCompiled = false;
+};
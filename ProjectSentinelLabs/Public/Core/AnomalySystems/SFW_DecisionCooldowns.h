@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionCooldowns.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AnomalySystems/SFW_DecisionTypes.h"
+#include "Core/AnomalySystems/SFW_DecisionSampler.h"
+
+/**
+ * Per-decision-type cooldowns: a dense ready-time array indexed by ESFWDecision
+ * plus a min-heap of pending expiries.
+ *
+ * Point lookups are one array read. The set of types still cooling down is kept
+ * as a bitmask that is only touched when a cooldown starts or the heap top
+ * expires, so "is anything eligible" and "when is the next one eligible" are O(1)
+ * between expiries.
+ */
+struct PROJECTSENTINELLABS_API FSFWDecisionCooldowns
+{
+	static constexpr int32 NumTypes = static_cast<int32>(ESFWDecision::ShadeAlert) + 1;
+
+	/** Type becomes eligible again at ReadyAt (world seconds). Replaces any running cooldown. */
+	void Start(ESFWDecision Type, double ReadyAt);
+
+	void Reset();
+
+	bool IsReady(ESFWDecision Type, double Now) const { return Now >= ReadyTime[Index(Type)]; }
+
+	/** Seconds until Type is eligible, 0 if it already is. */
+	double GetRemaining(ESFWDecision Type, double Now) const { return FMath::Max(0.0, ReadyTime[Index(Type)] - Now); }
+
+	/** Types still cooling down at Now. Pops expired heap entries. */
+	FSFWDecisionSampler::FTypeMask GetCoolingTypes(double Now);
+
+	/** True if any type in Types is eligible at Now. */
+	bool AnyReady(FSFWDecisionSampler::FTypeMask Types, double Now) { return (Types & ~GetCoolingTypes(Now)) != 0; }
+
+	/** World time the earliest running cooldown ends, or TNumericLimits<double>::Max() if none. */
+	double GetNextExpiry(double Now);
+
+private:
+	struct FExpiry
+	{
+		double ReadyAt = 0.0;
+		ESFWDecision Type = ESFWDecision::Idle;
+
+		bool operator<(const FExpiry& Other) const { return ReadyAt < Other.ReadyAt; }
+	};
+
+	static int32 Index(ESFWDecision Type) { return static_cast<int32>(Type); }
+
+	/** Drop heap entries that have expired or were superseded by a later Start. */
+	void PopExpired(double Now);
+
+	TStaticArray<double, NumTypes> ReadyTime{ InPlace, 0.0 };
+
+	/** Min-heap on ReadyAt. Restarted cooldowns leave stale entries that PopExpired skips. */
+	TArray<FExpiry> Heap;
+
+	FSFWDecisionSampler::FTypeMask Cooling = 0;
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionNetBundle.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AnomalySystems/SFW_DecisionTypes.h"
+#include "SFW_DecisionNetBundle.generated.h"
+
+/**
+ * Cosmetic decisions dispatched in one server frame, packed for a single
+ * unreliable multicast.
+ *
+ * Each decision is 8 bytes on the wire: type, an index into the bundle's room
+ * name table, Magnitude / Duration quantized to hundredths (0..655.35) and a
+ * 16-bit effect seed. Every entry shares the bundle's StartTime, since they were
+ * all dispatched in the same server frame. The instigator is not sent; it is
+ * always the decision system that receives it.
+ */
+USTRUCT()
+struct PROJECTSENTINELLABS_API FSFWDecisionBundle
+{
+	GENERATED_BODY()
+
+	/** Both the room table and the decision list are indexed / counted with a uint8. */
+	static constexpr int32 MaxEntries = MAX_uint8;
+
+	bool IsEmpty() const { return Entries.Num() == 0; }
+	bool IsFull() const { return Entries.Num() >= MaxEntries || Rooms.Num() >= MaxEntries; }
+
+	void Reset();
+
+	/** Append Payload. The caller flushes first when IsFull(). */
+	void Add(const FSFWDecisionPayload& Payload);
+
+	/** Expand back into payloads, in the order they were added. Entries with an unknown Type are dropped. */
+	void Unpack(AActor* Instigator, TArray<FSFWDecisionPayload>& OutPayloads) const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** Value as clients unpack it (Magnitude / Duration), for the host to play the same thing. */
+	static float RoundTrip(float Value) { return Dequantize(Quantize(Value)); }
+
+private:
+	struct FEntry
+	{
+		uint8 Type = 0;
+		uint8 RoomSlot = 0;
+		uint16 Magnitude = 0;
+		uint16 Duration = 0;
+		uint16 Seed = 0;
+	};
+
+	static uint16 Quantize(float Value);
+	static float Dequantize(uint16 Value) { return Value / 100.f; }
+
+	double StartTime = 0.0;
+	TArray<FName> Rooms;
+	TArray<FEntry> Entries;
+};
+
+template<>
+struct TStructOpsTypeTraits<FSFWDecisionBundle> : public TStructOpsTypeTraitsBase2<FSFWDecisionBundle>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
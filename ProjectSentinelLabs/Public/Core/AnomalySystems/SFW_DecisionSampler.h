@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSampler.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Core/AnomalySystems/SFW_CompiledDecisionTables.h"
+
+/**
+ * Weighted decision picker compiled from decision rows (USFW_CompiledDecisionTables,
+ * or a DecisionsDT read through it).
+ *
+ * Rows are copied and grouped by Tier with their profile-biased weights baked in. Each tier
+ * keeps a Vose alias table over the rows whose type is currently allowed, so a
+ * draw is one random slot plus one coin flip. The alias table is rebuilt only when
+ * the allowed-type mask for that tier changes; the whole sampler recompiles when
+ * the source or the biases change.
+ *
+ * DrawShared never writes, so a compiled sampler can be read from a worker while the
+ * game thread keeps the only writable reference; a table it had to rebuild is handed
+ * back for AdoptAlias.
+ */
+struct PROJECTSENTINELLABS_API FSFWDecisionSampler
+{
+	/** One bit per ESFWDecision value. */
+	using FTypeMask = uint64;
+
+	static FTypeMask TypeBit(ESFWDecision Type) { return FTypeMask(1) << static_cast<uint8>(Type); }
+
+	/** Profile bias for a decision type (door / light families, 1 otherwise). */
+	static float GetBias(ESFWDecision Type, float DoorBias, float LightBias);
+
+	/** True if the sampler already reflects Source's rows with these biases. */
+	bool IsCompiledFor(const UObject* Source, float DoorBias, float LightBias) const
+	{
+		return Source && Source == CompiledSource && DoorBias == CompiledDoorBias && LightBias == CompiledLightBias;
+	}
+
+	/** Group Rows by tier with biased weights. Rows with no weight are dropped. Source identifies them for IsCompiledFor. */
+	void Compile(const UObject* Source, TConstArrayView<FSFWDecisionRowView> Rows, float DoorBias, float LightBias);
+
+	void Reset();
+
+	/** Union of every compiled row type, across tiers. */
+	FTypeMask GetTypes() const { return AllTypes; }
+
+	/** Alias table over the allowed subset of one tier's rows (indices in Eligible). */
+	struct FAliasTable
+	{
+		FTypeMask BuiltMask = 0;
+		bool bBuilt = false;
+		TArray<int32> Eligible;
+		TArray<float> Prob;
+		TArray<int32> Alias;
+	};
+
+	/**
+	 * Weighted pick among Tier's rows whose type bit is set in AllowedTypes,
+	 * or nullptr if none qualifies. Valid until the next Compile / Reset.
+	 */
+	const FSFWDecisionRowView* Draw(int32 Tier, FTypeMask AllowedTypes, FRandomStream& Rng);
+
+	/**
+	 * Draw without touching the sampler. If Tier's cached table doesn't match the mask,
+	 * one is built into OutRebuilt (bBuilt set) and drawn from instead.
+	 */
+	const FSFWDecisionRowView* DrawShared(int32 Tier, FTypeMask AllowedTypes, FRandomStream& Rng, FAliasTable& OutRebuilt) const;
+
+	/** Keep a table DrawShared built for Tier, so later draws with that mask reuse it. */
+	void AdoptAlias(int32 Tier, FAliasTable&& Table);
+
+private:
+	struct FTierTable
+	{
+		TArray<FSFWDecisionRowView> Rows;
+		TArray<float> Weights;
+
+		/** Union of the row types in this tier. */
+		FTypeMask Types = 0;
+
+		FAliasTable Cached;
+
+		void BuildAlias(FTypeMask Mask, FAliasTable& Out) const;
+		const FSFWDecisionRowView* DrawFrom(const FAliasTable& Table, FRandomStream& Rng) const;
+	};
+
+	TMap<int32, FTierTable> Tiers;
+	FTypeMask AllTypes = 0;
+
+	const UObject* CompiledSource = nullptr;
+	float CompiledDoorBias = 1.f;
+	float CompiledLightBias = 1.f;
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSelector.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AnomalySystems/SFW_DecisionSampler.h"
+#include "Core/AnomalySystems/SFW_DecisionCooldowns.h"
+
+struct FSFWRoomGraph;
+
+/**
+ * Everything one decision evaluation reads about the world, copied on the game
+ * thread so the evaluation itself can run anywhere.
+ */
+struct FSFWDecisionInput
+{
+	double Now = 0.0;
+
+	/** Room the Shade is in, or NAME_None. It wins over the players' rooms. */
+	FName ShadeRoom;
+	int32 ShadeRoomTier = 1;
+
+	/** Non-safe rooms with players, and their worst sanity tier. */
+	TArray<TPair<FName, int32>> OccupiedRooms;
+
+	/** Never targeted when widening past the occupied rooms. */
+	TArray<FName> SafeRooms;
+
+	/** Door graph (null = occupied rooms only). Must outlive the evaluation. */
+	const FSFWRoomGraph* Graph = nullptr;
+
+	int32 TargetHops = 0;
+	float IntervalSec = 2.f;
+};
+
+enum class ESFWDecisionOutcome : uint8
+{
+	Decided,
+	NoTarget,		// No Shade room and nobody in a targetable room
+	AllCooling,		// Every compiled type is cooling down
+	TierCooling,	// The target tier's types are cooling down
+};
+
+struct FSFWDecisionResult
+{
+	ESFWDecisionOutcome Outcome = ESFWDecisionOutcome::NoTarget;
+
+	/** Valid when Decided. */
+	FSFWDecisionRowView Row;
+	FName RoomId;
+	int32 Tier = 1;
+
+	/** Next world time worth evaluating, or TNumericLimits<double>::Max() to sleep until woken. */
+	double WakeTime = TNumericLimits<double>::Max();
+
+	/** Alias table built during the draw (RebuiltAlias.bBuilt), for FSFWDecisionSelector::AdoptRebuilt. */
+	int32 RebuiltTier = INDEX_NONE;
+	FSFWDecisionSampler::FAliasTable RebuiltAlias;
+	TSharedPtr<const FSFWDecisionSampler> SamplerUsed;
+};
+
+/**
+ * Read-only state one evaluation needs from a selector: the compiled sampler,
+ * shared rather than copied, and the cooldowns resolved at Now on the game thread.
+ */
+struct FSFWDecisionSelectorView
+{
+	TSharedRef<const FSFWDecisionSampler> Sampler;
+	FSFWDecisionSampler::FTypeMask CoolingTypes = 0;
+	double NextExpiry = TNumericLimits<double>::Max();
+};
+
+/**
+ * The world-free part of ASFW_AnomalyDecisionSystem: profile bias, per-tier
+ * weighted picks and per-type cooldowns. Time and randomness are passed in, so
+ * the same selection runs in the actor and in USFW_DecisionSimCommandlet.
+ */
+struct PROJECTSENTINELLABS_API FSFWDecisionSelector
+{
+	/**
+	 * Compile Rows with the given biases unless already compiled for Source and them.
+	 * Source identifies where Rows came from (compiled asset or DataTable). False without one.
+	 */
+	bool Prepare(const UObject* Source, TConstArrayView<FSFWDecisionRowView> Rows, float DoorBias, float LightBias);
+
+	/** Drop compiled rows (the source changed). */
+	void Invalidate() { Sampler = MakeShared<FSFWDecisionSampler>(); }
+
+	/** True if any compiled decision type is off cooldown at Now. */
+	bool AnyReady(double Now) { return Cooldowns.AnyReady(Sampler->GetTypes(), Now); }
+
+	/** Weighted pick among Tier's rows that are off cooldown; does not start a cooldown. */
+	const FSFWDecisionRowView* Pick(int32 Tier, double Now, FRandomStream& Rng)
+	{
+		return MutableSampler().Draw(Tier, ~Cooldowns.GetCoolingTypes(Now), Rng);
+	}
+
+	/**
+	 * Choose a target room, its tier and a decision for Input, the way
+	 * ASFW_AnomalyDecisionSystem always has. Does not start a cooldown. Needs Prepare first.
+	 */
+	FSFWDecisionResult Evaluate(const FSFWDecisionInput& Input, FRandomStream& Rng);
+
+	/** Game thread: snapshot for evaluating at Now elsewhere. */
+	FSFWDecisionSelectorView MakeView(double Now);
+
+	/** Evaluate against a view; touches no selector, so it is safe on a worker. */
+	static FSFWDecisionResult Evaluate(const FSFWDecisionSelectorView& View, const FSFWDecisionInput& Input, FRandomStream& Rng);
+
+	/** Game thread: keep the alias table Result rebuilt, if it came from the current sampler. */
+	void AdoptRebuilt(FSFWDecisionResult& Result);
+
+	/** Start Row's cooldown as of Now. */
+	void Commit(const FSFWDecisionRowView& Row, double Now) { Cooldowns.Start(Row.Type, Now + Row.CooldownSec); }
+
+	FSFWDecisionCooldowns& GetCooldowns() { return Cooldowns; }
+	const FSFWDecisionCooldowns& GetCooldowns() const { return Cooldowns; }
+
+private:
+	/** Copy-on-write: cloned first if a view handed to a worker still holds it. */
+	FSFWDecisionSampler& MutableSampler();
+
+	TSharedRef<FSFWDecisionSampler> Sampler = MakeShared<FSFWDecisionSampler>();
+	FSFWDecisionCooldowns Cooldowns;
+};
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_DecisionSimCommandlet.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SFW_DecisionSimCommandlet.generated.h"
+
+/**
+ * Runs the anomaly decision selection (FSFWDecisionSelector: weights, profile
+ * bias, tiers, cooldowns) against a synthetic room graph and wandering players,
+ * with no map, rendering or networking. Reports throughput, per-type frequency
+ * and cooldown utilization for tuning DecisionsDT.
+ *
+ * UnrealEditor-Cmd ProjectSentinelLabs -run=SFW_DecisionSim -Table=/Game/Data/DA_DecisionTables
+ *   [-Anomaly=Binder] [-DoorBias=1 -LightBias=1]
+ *
+ * -Table may also be a DataTable of FSFWDecisionRow, with the profile from -Profiles=<DataTable>.
+ * Other options: [-Ticks=1000000] [-Interval=2] [-Rooms=12] [-Players=4] [-Hops=0]
+ *   [-MoveSec=30] [-TierSec=600] [-Seed=1]
+ *
+ * One tick is one decision evaluation, scheduled the way ASFW_AnomalyDecisionSystem
+ * schedules them: IntervalSec after a decision, otherwise at the next cooldown
+ * expiry or player room change.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_DecisionSimCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USFW_DecisionSimCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -15,9 +15,11 @@ enum class ESFWAnomalyType : uint8
     Watcher  UMETA(DisplayName = "Watcher"),
     Chill    UMETA(DisplayName = "Chill"),
     Parasite UMETA(DisplayName = "Parasite"),
-    Splitter UMETA(DisplayName = "Splitter")
+    Splitter UMETA(DisplayName = "Splitter"),
     // Add more types here later:
     // Whisperer
+
+    MAX      UMETA(Hidden)  // Keep last: number of types
 };
 
 
@@ -132,4 +134,10 @@ struct FSFWDecisionPayload
 
     // Weak on purpose; payloads are transient and should not pin actors for GC
     UPROPERTY() TWeakObjectPtr<AActor> Instigator = nullptr; // replaces raw AActor*
+
+    // Server world time the decision fired, and the seed every machine regenerates
+    // the effect timeline from (see ASFW_AnomalyDecisionSystem::bSynthesizeLampEffects).
+    // Double: a float of server time loses millisecond precision a few hours in.
+    UPROPERTY(BlueprintReadWrite) double       StartTime = 0.0;
+    UPROPERTY(BlueprintReadWrite) int32        Seed = 0;
 };
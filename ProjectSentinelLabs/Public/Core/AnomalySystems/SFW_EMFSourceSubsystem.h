@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_EMFSourceSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_EMFSourceSubsystem.generated.h"
+
+class AActor;
+
+/**
+ * Server-side registry of EMF sources, stored in a uniform XY grid.
+ *
+ * Sources are registered explicitly (with an optional expiry and a strength) by
+ * USFW_PowerLibrary::MakeActorEMFSource, and cleared early by
+ * USFW_PowerLibrary::ClearActorEMFSource. Level-placed actors tagged "EMF_Source"
+ * are picked up once at world begin play. EMF devices query by radius and only
+ * touch the cells that radius covers.
+ *
+ * Expired sources are dropped, and movable sources (tossed props) are re-bucketed,
+ * lazily at most once per frame before a query.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_EMFSourceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_EMFSourceSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Register (or refresh) Source. Seconds <= 0 keeps it until UnregisterSource.
+	 * Re-registering keeps the later expiry. Strength scales the signal (1 = legacy full strength).
+	 */
+	void RegisterSource(AActor* Source, float Seconds, float Strength = 1.f);
+	void UnregisterSource(AActor* Source);
+
+	bool IsSource(const AActor* Source) const;
+
+	/**
+	 * Strongest signal in [0..1] at Origin: Strength * linear falloff over Radius,
+	 * from the best source within Radius. Ignore is skipped (e.g. the device itself).
+	 */
+	float QueryStrongestSignal(const FVector& Origin, float Radius, const AActor* Ignore = nullptr);
+
+	/** Grid cell edge length in cm. */
+	static constexpr float CellSize = 500.f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FSource
+	{
+		TWeakObjectPtr<AActor> Actor;
+		double ExpireTime = 0.0; // 0 = never
+		float Strength = 1.f;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		bool bMovable = false;
+	};
+
+	static FIntPoint CellFor(const FVector& Location);
+
+	/** Drop expired / dead sources and re-bucket movable ones. Once per frame. */
+	void RefreshSources();
+
+	void AddToCell(const FIntPoint& Cell, int32 SourceIndex);
+	void RemoveFromCell(const FIntPoint& Cell, int32 SourceIndex);
+	void RemoveSourceAt(int32 SourceIndex);
+
+	/** Dense-ish source storage; freed slots are reused. */
+	TSparseArray<FSource> Sources;
+
+	/** Actor -> index into Sources. */
+	TMap<TWeakObjectPtr<const AActor>, int32> IndexByActor;
+
+	/** Cell -> indices into Sources. */
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	uint64 LastRefreshFrame = MAX_uint64;
+};
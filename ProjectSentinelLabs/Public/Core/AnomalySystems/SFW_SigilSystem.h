@@ -26,6 +26,7 @@ public:
 	ASFW_SigilSystem();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	/** How many sigils are visible/active in the current run. Binder uses 4. */
@@ -70,6 +71,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Sigil")
 	bool IsPuzzleComplete() const { return bPuzzleComplete; }
 
+	/**
+	 * Server: active, uncleansed sigils inside a cone (used by UV lights).
+	 * Only the current layout is indexed; a bounding-sphere cull runs before the angle test.
+	 */
+	void QuerySigilsInCone(const FVector& Origin, const FVector& Direction, float Range, float ConeHalfAngleDeg,
+		TArray<ASFW_SigilActor*>& OutSigils) const;
+
 protected:
 	/** True while a layout is active for the current run. */
 	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Sigil")
@@ -99,4 +107,24 @@ protected:
 
 	/** Helper: choose RequiredVisibleSigils from Pool, mark RequiredRealSigils as real. */
 	void BuildRandomLayoutFromPool(const TArray<ASFW_SigilActor*>& Pool);
+
+	// ---- Cone query index (server) ----
+
+	struct FSigilQueryEntry
+	{
+		TWeakObjectPtr<ASFW_SigilActor> Sigil;
+		FVector Location = FVector::ZeroVector;
+	};
+
+	/** Active sigils not yet cleansed, with cached locations. */
+	TArray<FSigilQueryEntry> QueryIndex;
+
+	/** Sphere enclosing every QueryIndex location. */
+	FSphere QueryBounds = FSphere(ForceInit);
+
+	/** Sigils cleansed during the current layout. */
+	TSet<TWeakObjectPtr<ASFW_SigilActor>> CleansedSigils;
+
+	/** Rebuild QueryIndex from ActiveSigils minus CleansedSigils. */
+	void RebuildQueryIndex();
 };
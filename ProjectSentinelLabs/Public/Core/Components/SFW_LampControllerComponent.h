@@ -34,14 +34,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Lamp")
 	void SetState(ELampState NewState, float OptionalDurationSeconds = -1.f);
 
+	/**
+	 * Local only, no replication: flicker from StartTime (server world time) for Duration,
+	 * regenerating the pattern from Seed. Every machine given the same record produces the
+	 * same pattern for this lamp; a late call fast-forwards to where the pattern is now.
+	 * Ignored unless the lamp is On, and any replicated state change cancels it.
+	 */
+	void PlaySynthesizedFlicker(double StartTime, float Duration, int32 Seed);
+
 	/** Force re-scan of mesh materials and rebuild MIDs (emissive path). */
 	UFUNCTION(BlueprintCallable, Category = "Lamp")
 	void RebuildMaterialInstances();
 
-	/** Lamp's logical room identifier (optional). */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lamp|Room")
+	/** Lamp's logical room identifier (optional). Changed through SetRoomId so the lamp registry stays in sync. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lamp|Room")
 	FName RoomId = NAME_None;
 
+	/** Change RoomId and move the lamp to the matching registry bucket. */
+	UFUNCTION(BlueprintCallable, Category = "Lamp|Room")
+	void SetRoomId(FName NewRoomId);
+
 	// ---------- Visual Mode A: Material Swap ----------
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lamp|Visual")
 	bool bUseMaterialSwap = false; // default to emissive path
@@ -107,6 +119,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	UFUNCTION() void OnRep_State();
 
 private:
@@ -119,6 +132,29 @@ private:
 	FTimerHandle FlickerTimer;
 	FTimerHandle RestoreTimer;
 
+	/** One step of a flicker pattern. */
+	struct FFlickerFrame
+	{
+		bool bPopOff = false;
+		float Emissive = 0.f;
+		float LightMultiplier = 1.f;
+		float Interval = 0.1f;
+	};
+
+	// Synthesized flicker (PlaySynthesizedFlicker)
+	FRandomStream SynthRng;
+
+	/**
+	 * Per-lamp seed salt, the same on every machine: the PIE-stripped path name for
+	 * level-placed lamps, the server's value (replicated) for spawned ones.
+	 */
+	UPROPERTY(Replicated)
+	int32 FlickerSalt = 0;
+
+	double SynthNextFrameTime = 0.0;
+	double SynthEndTime = 0.0;
+	bool bSynthFlickerActive = false;
+
 	// Core
 	void ApplyState();
 	void ApplyMaterialOn();
@@ -127,6 +163,12 @@ private:
 	void StartFlicker();
 	void StopFlicker();
 	void TickFlickerOnce();
+	void TickSynthesizedFlicker();
+
+	/** Draw the next frame from Rng. Consumes the same values whether or not it is applied. */
+	FFlickerFrame DrawFlickerFrame(FRandomStream& Rng) const;
+	void ApplyFlickerFrame(const FFlickerFrame& Frame);
+	double GetServerTime() const;
 
 	// Helpers
 	UMeshComponent* ResolveMesh() const;
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoundRandomSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_RoundRandomSubsystem.generated.h"
+
+/** Stream names used by gameplay systems. Each gets its own sequence derived from the round seed. */
+namespace SFWRandomStreams
+{
+	extern PROJECTSENTINELLABS_API const FName AnomalyController;
+	extern PROJECTSENTINELLABS_API const FName Decisions;
+	extern PROJECTSENTINELLABS_API const FName Lamps;
+	extern PROJECTSENTINELLABS_API const FName Sigils;
+	extern PROJECTSENTINELLABS_API const FName Props;
+	extern PROJECTSENTINELLABS_API const FName Patrol;
+}
+
+/**
+ * Round-seeded random streams, one per named system.
+ *
+ * Every stream is seeded from ASFW_GameState::RoundSeed and its own name, so one
+ * system drawing more or fewer numbers never shifts another system's sequence.
+ * Streams reseed automatically when the replicated RoundSeed changes, which also
+ * keeps clients in step once the GameState arrives.
+ *
+ * Pass -SFWRoundSeed=<int> on the command line to force the seed ChooseRoundSeed
+ * hands out, making a run (perf capture, regression repro) exactly repeatable.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_RoundRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_RoundRandomSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Stream for StreamName in WorldContextObject's world. Falls back to a shared
+	 * unseeded stream where the subsystem doesn't exist (editor worlds).
+	 */
+	static FRandomStream& GetStream(const UObject* WorldContextObject, FName StreamName);
+
+	/** Seed for a new round: the -SFWRoundSeed override if present, otherwise random. Server only. */
+	static int32 ChooseRoundSeed();
+
+	FRandomStream& GetStream(FName StreamName);
+
+	/** Seed the streams are currently derived from. */
+	int32 GetRoundSeed() const { return CurrentSeed; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+private:
+	/** Reseed every stream if the GameState's RoundSeed moved on. */
+	void SyncWithRoundSeed();
+
+	TMap<FName, FRandomStream> Streams;
+
+	int32 CurrentSeed = 0;
+};
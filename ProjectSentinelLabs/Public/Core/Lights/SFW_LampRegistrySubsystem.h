@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_LampRegistrySubsystem.generated.h"
+
+class USFW_LampControllerComponent;
+
+/**
+ * Registry of lamp controllers, bucketed by RoomId.
+ * Lamps join on BeginPlay and leave on EndPlay, so room power effects only touch
+ * the lamps in the affected room instead of scanning every actor.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_LampRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_LampRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	void RegisterLamp(USFW_LampControllerComponent* Lamp);
+	void UnregisterLamp(USFW_LampControllerComponent* Lamp);
+
+	/** Move a registered lamp to the bucket for its current RoomId. */
+	void UpdateLampRoom(USFW_LampControllerComponent* Lamp);
+
+	/** Every registered lamp (site-wide). */
+	const TArray<TObjectPtr<USFW_LampControllerComponent>>& GetAllLamps() const { return AllLamps; }
+
+	/** Lamps whose RoomId matches. Empty if none. */
+	const TArray<USFW_LampControllerComponent*>& GetLampsInRoom(FName RoomId) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USFW_LampControllerComponent>> AllLamps;
+
+	/** RoomId -> lamps. Lamps leave on EndPlay, so raw pointers stay valid. */
+	TMap<FName, TArray<USFW_LampControllerComponent*>> LampsByRoom;
+
+	/** Bucket each lamp was filed under (RoomId may be edited after registering). */
+	TMap<const USFW_LampControllerComponent*, FName> RegisteredRoom;
+};
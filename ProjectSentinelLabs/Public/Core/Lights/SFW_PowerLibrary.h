@@ -29,6 +29,13 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = "SFW|Power")
 	static void FlickerRoom(UObject* WorldContextObject, FName RoomId, float Seconds = 3.f);
 
+	/**
+	 * Play a flicker pattern regenerated from Seed on lamps with matching RoomId, on this
+	 * machine only. Call it with the same arguments everywhere to get the same result.
+	 */
+	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = "SFW|Power")
+	static void PlayFlickerRoomLocal(UObject* WorldContextObject, FName RoomId, double StartTime, float Seconds, int32 Seed);
+
 	/** Trigger a temporary EMF spike on all EMF devices. Server only has effect. */
 	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = "SFW|Power")
 	static void TriggerEMFBurst(UObject* WorldContextObject, int32 Level = 5, float Seconds = 4.f);
@@ -37,10 +44,15 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = "SFW|Power")
 	static void MakeActorEMFSource(UObject* WorldContextObject, AActor* TargetActor, float Seconds = 10.f);
 
+	/** Stop an actor being an EMF source before its time runs out. Server only has effect. */
+	UFUNCTION(BlueprintCallable, meta = (WorldContext = "WorldContextObject"), Category = "SFW|Power")
+	static void ClearActorEMFSource(UObject* WorldContextObject, AActor* TargetActor);
+
 private:
 	static UWorld* GetWorldChecked(UObject* WorldContextObject);
 	static bool IsServer(UWorld* World);
 
-	static void ForEachLamp(UWorld* World, TFunctionRef<void(USFW_LampControllerComponent*)> Fn);
-	static void ForEachLampInRoom(UWorld* World, FName RoomId, TFunctionRef<void(USFW_LampControllerComponent*)> Fn);
+	/** Visit registered lamps (see USFW_LampRegistrySubsystem). Both return the site-wide lamp count for logging. */
+	static int32 ForEachLamp(UWorld* World, TFunctionRef<void(USFW_LampControllerComponent*)> Fn);
+	static int32 ForEachLampInRoom(UWorld* World, FName RoomId, TFunctionRef<void(USFW_LampControllerComponent*)> Fn);
 };
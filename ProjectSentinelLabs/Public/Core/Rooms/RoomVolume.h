@@ -55,8 +55,16 @@ public:
     UFUNCTION(BlueprintPure, Category = "Room|Type") bool IsSafeKind()     const { return RoomType == ERoomType::Safe; }
     UFUNCTION(BlueprintPure, Category = "Room|Type") bool IsRiftCandidate()const { return RoomType == ERoomType::RiftCandidate; }
 
+    // ---- Spatial helpers ----
+    /** Exact test against the (possibly rotated) trigger box. */
+    bool ContainsPoint(const FVector& Location) const;
+
+    /** World-space AABB of the trigger box. */
+    FBox GetRoomBounds() const;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UFUNCTION() void HandleBeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
     UFUNCTION() void HandleEndOverlap(AActor* OverlappedActor, AActor* OtherActor);
@@ -66,10 +74,7 @@ protected:
 #endif
 
 private:
-    /** Per-actor debounce to avoid doorway spam. */
-    UPROPERTY() TMap<TWeakObjectPtr<AActor>, float> LastEventTime;
-
-        /** Minimum seconds between events for the same actor. */
+    /** Minimum seconds between events for the same actor (debounce state lives in USFW_RoomOccupancySubsystem). */
     UPROPERTY(EditAnywhere, Category = "Room|Tuning")
     float DebounceSeconds = 0.15f;
 
@@ -85,6 +90,9 @@ private:
     ASFW_PlayerState* GetSFWPlayerStateFromActor(AActor* Actor) const;
     bool ShouldProcess(AActor* Actor);
 
+    /** Re-resolve Actor's room in the prop registry if it is an anomaly prop. */
+    void UpdatePropRegistry(AActor* Actor) const;
+
     void NotifyPresenceChanged(APlayerState* PS, bool bEnter) const;
 
     /** Adjust safe-room state for a player by +1 / -1 overlaps. */
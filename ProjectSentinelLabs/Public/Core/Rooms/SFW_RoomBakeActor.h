@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomBakeActor.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Core/Rooms/SFW_RoomGraph.h"
+#include "SFW_RoomBakeActor.generated.h"
+
+/**
+ * Axis-aligned world grid of room cells. Each cell stores an index into RoomIds
+ * (0 = no room), so a point lookup is one division and one array read.
+ */
+USTRUCT()
+struct PROJECTSENTINELLABS_API FSFWRoomCellGrid
+{
+	GENERATED_BODY()
+
+	/** World-space min corner of cell (0,0,0). */
+	UPROPERTY(VisibleAnywhere, Category = "Room Grid")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Grid")
+	float CellSize = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Grid")
+	FIntVector Dims = FIntVector::ZeroValue;
+
+	/** Palette: Cells value N maps to RoomIds[N - 1]. */
+	UPROPERTY(VisibleAnywhere, Category = "Room Grid")
+	TArray<FName> RoomIds;
+
+	/** X-major cell array, Dims.X * Dims.Y * Dims.Z entries. */
+	UPROPERTY()
+	TArray<uint8> Cells;
+
+	bool IsValid() const { return CellSize > 0.f && Cells.Num() > 0 && Cells.Num() == Dims.X * Dims.Y * Dims.Z; }
+
+	/** Flat cell index containing Location, or INDEX_NONE outside the grid. */
+	int32 CellIndexAt(const FVector& Location) const;
+
+	/** World-space centre of a flat cell index. */
+	FVector CellCenter(int32 CellIndex) const;
+
+	/**
+	 * RoomId at Location. Returns false when Location is outside the grid (caller may
+	 * fall back to another lookup); true with NAME_None for in-grid cells with no room.
+	 */
+	bool FindRoomId(const FVector& Location, FName& OutRoomId) const;
+
+	/**
+	 * Mark the cells whose room also fills all 26 neighbours. Only those can answer a
+	 * lookup on their own; empty cells and cells on a room border may straddle a wall.
+	 */
+	void BuildInteriorMask(TBitArray<>& OutInterior) const;
+
+	FName GetCellRoomId(int32 CellIndex) const
+	{
+		const uint8 Slot = Cells[CellIndex];
+		return Slot ? RoomIds[Slot - 1] : NAME_None;
+	}
+};
+
+/**
+ * Level-placed holder for the baked room grid. Place one per level and press
+ * "Bake Room Grid" after editing room volumes; the grid is saved with the level.
+ * USFW_RoomIndexSubsystem picks it up at world begin play and answers RoomId
+ * queries from it in constant time.
+ *
+ * "Bake Room Graph" does the same for the door adjacency graph (re-bake after
+ * moving doors or rooms); without it the index builds the graph at begin play.
+ */
+UCLASS(NotBlueprintable)
+class PROJECTSENTINELLABS_API ASFW_RoomBakeActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ASFW_RoomBakeActor();
+
+	/** Cell edge length in cm. Smaller is more accurate at walls but costs memory. */
+	UPROPERTY(EditAnywhere, Category = "Room Bake", meta = (ClampMin = "10.0"))
+	float CellSize = 50.f;
+
+	/** Voxelize every ARoomVolume in the level into Grid and report problems. */
+	UFUNCTION(CallInEditor, Category = "Room Bake")
+	void BakeRoomGrid();
+
+	/** Re-voxelize without saving; reports overlaps, gaps and cells that differ from the bake. */
+	UFUNCTION(CallInEditor, Category = "Room Bake")
+	void ValidateRoomGrid() const;
+
+	/** How far in front of / behind each door frame to look for the rooms it joins (cm). */
+	UPROPERTY(EditAnywhere, Category = "Room Bake", meta = (ClampMin = "10.0"))
+	float PortalProbeDistance = 100.f;
+
+	/** Link every room through the doors between them and precompute hop distances. */
+	UFUNCTION(CallInEditor, Category = "Room Bake")
+	void BakeRoomGraph();
+
+	const FSFWRoomCellGrid& GetGrid() const { return Grid; }
+	const FSFWRoomGraph& GetRoomGraph() const { return RoomGraph; }
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Room Bake")
+	FSFWRoomCellGrid Grid;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Bake")
+	FSFWRoomGraph RoomGraph;
+
+private:
+	struct FBakeReport
+	{
+		int32 NumRooms = 0;
+		int32 CoveredCells = 0;
+		int32 OverlapCells = 0;   // claimed by more than one RoomId
+		int32 AmbiguousCells = 0; // ...of which at equal Priority
+		int32 GapCells = 0;       // empty cells sandwiched between covered cells
+		TArray<FName> EmptyRooms; // rooms smaller than a cell
+	};
+
+	/** Upper bound on grid size so a stray volume can't allocate gigabytes. */
+	static constexpr int64 MaxCells = 32 * 1024 * 1024;
+
+	bool Voxelize(FSFWRoomCellGrid& OutGrid, FBakeReport& OutReport) const;
+	void LogReport(const TCHAR* What, const FSFWRoomCellGrid& InGrid, const FBakeReport& Report) const;
+};
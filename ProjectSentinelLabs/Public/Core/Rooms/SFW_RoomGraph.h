@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomGraph.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SFW_RoomGraph.generated.h"
+
+class ASFW_DoorBase;
+class UWorld;
+
+/** One door joining two rooms. RoomB is INDEX_NONE when the far side resolves to no room. */
+USTRUCT()
+struct PROJECTSENTINELLABS_API FSFWRoomPortal
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	int32 RoomA = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	int32 RoomB = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	TObjectPtr<ASFW_DoorBase> Door = nullptr;
+
+	/** Door location at bake time. */
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	FVector Location = FVector::ZeroVector;
+
+	/** The room on the other side of this portal from RoomIndex, or INDEX_NONE. */
+	int32 GetOtherRoom(int32 RoomIndex) const
+	{
+		return RoomIndex == RoomA ? RoomB : (RoomIndex == RoomB ? RoomA : INDEX_NONE);
+	}
+};
+
+/**
+ * Room adjacency graph: one node per RoomId, one edge per door (portal) between
+ * two rooms, plus an all-pairs hop table so "rooms within K hops" and "doors on
+ * the boundary of room X" are table reads instead of actor scans.
+ *
+ * Built from the level's ARoomVolume and ASFW_DoorBase actors. Each door is
+ * assigned to the rooms found a short distance in front of and behind its frame;
+ * a door whose RoomID is set always counts as a boundary door of that room.
+ */
+USTRUCT()
+struct PROJECTSENTINELLABS_API FSFWRoomGraph
+{
+	GENERATED_BODY()
+
+	/** Hop table value for rooms with no door path between them. */
+	static constexpr uint8 Unreachable = MAX_uint8;
+
+	/** Node index -> RoomId. */
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	TArray<FName> RoomIds;
+
+	UPROPERTY(VisibleAnywhere, Category = "Room Graph")
+	TArray<FSFWRoomPortal> Portals;
+
+	/** Portals of node N are RoomPortals[RoomPortalStart[N] .. RoomPortalStart[N + 1]). */
+	UPROPERTY()
+	TArray<int32> RoomPortalStart;
+
+	/** Portal indices grouped by node (see RoomPortalStart). */
+	UPROPERTY()
+	TArray<int32> RoomPortals;
+
+	/** Row-major RoomIds.Num() squared hop counts, clamped below Unreachable. */
+	UPROPERTY()
+	TArray<uint8> Hops;
+
+	bool IsValid() const
+	{
+		const int32 Num = RoomIds.Num();
+		return Num > 0 && RoomPortalStart.Num() == Num + 1 && Hops.Num() == Num * Num;
+	}
+
+	/**
+	 * Rebuild from the rooms and doors in World. ResolveRoomId maps a location to a
+	 * RoomId (or NAME_None); ProbeDistance is how far either side of a door frame is
+	 * sampled. Returns false when World has no rooms.
+	 */
+	static bool Build(UWorld* World, TFunctionRef<FName(const FVector&)> ResolveRoomId, float ProbeDistance, FSFWRoomGraph& OutGraph);
+
+	/**
+	 * Rebuild the lookup, per-room portal lists and hop table from RoomIds and
+	 * Portals. Lets a graph be assembled by hand (headless simulation) as well as by Build.
+	 */
+	void Finalize();
+
+	/** Rebuild the RoomId -> node lookup. Call after loading or copying a graph. */
+	void BuildLookup();
+
+	/** Node index of RoomId, or INDEX_NONE. */
+	int32 FindRoomIndex(FName RoomId) const
+	{
+		const int32* Index = IndexById.Find(RoomId);
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	/** Doors to cross between two rooms, 0 for the same room, INDEX_NONE if unknown or unreachable. */
+	int32 GetHopDistance(FName FromRoom, FName ToRoom) const;
+
+	/** Append every room at most MaxHops doors away from any of SourceRooms (sources included). */
+	void GetRoomsWithinHops(TConstArrayView<FName> SourceRooms, int32 MaxHops, TArray<FName>& OutRooms) const;
+
+	/** Append the doors that lead into or out of RoomId. */
+	void GetBoundaryDoors(FName RoomId, TArray<ASFW_DoorBase*>& OutDoors) const;
+
+	/** Append the rooms sharing a door with RoomId. */
+	void GetAdjacentRooms(FName RoomId, TArray<FName>& OutRooms) const;
+
+private:
+	void BuildHops();
+
+	/** Transient; rebuilt by BuildLookup. */
+	TMap<FName, int32> IndexById;
+};
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomIndexSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/Rooms/SFW_RoomGraph.h"
+#include "SFW_RoomIndexSubsystem.generated.h"
+
+class ARoomVolume;
+class ASFW_RoomBakeActor;
+
+/**
+ * World-level spatial index over ARoomVolume.
+ *
+ * Rooms register themselves on BeginPlay / EndPlay. Point queries walk a small
+ * AABB bounding volume hierarchy (rebuilt lazily when the room set changes) and
+ * then run an exact oriented-box test, so lookups cost O(log rooms) instead of
+ * iterating every room in the world.
+ *
+ * If the level contains an ASFW_RoomBakeActor with a baked grid, RoomId lookups
+ * in cells deep inside one room are answered from it in O(1). Empty cells, cells
+ * on a room border and points outside the grid use the exact hierarchy test, so
+ * both paths always agree with FindRoomAtLocation.
+ * Its baked room graph is used as-is; otherwise the graph is built from the
+ * level's rooms and doors at world begin play.
+ *
+ * Only exists in game / PIE worlds; editor-time callers should fall back to
+ * iterating rooms themselves.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_RoomIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** Convenience accessor; returns nullptr if the world has no index (editor worlds, no world). */
+	static USFW_RoomIndexSubsystem* Get(const UObject* WorldContextObject);
+
+	// ---- Registration (called by ARoomVolume) ----
+	void RegisterRoom(ARoomVolume* Room);
+	void UnregisterRoom(ARoomVolume* Room);
+
+	/** Mark the hierarchy stale, e.g. after a room volume was moved at runtime. */
+	void MarkDirty() { bTreeDirty = true; }
+
+	// ---- Queries ----
+
+	/** Room volume containing Location. When volumes overlap, higher Priority wins. */
+	ARoomVolume* FindRoomAtLocation(const FVector& Location) const;
+
+	/** RoomId of the room containing Location, or NAME_None. Uses the baked grid when available. */
+	UFUNCTION(BlueprintPure, Category = "Rooms")
+	FName FindRoomIdAtLocation(const FVector& Location) const;
+
+	/** True if Location resolves to RoomId (any of its volumes). */
+	bool IsLocationInRoom(FName RoomId, const FVector& Location) const
+	{
+		return !RoomId.IsNone() && FindRoomIdAtLocation(Location) == RoomId;
+	}
+
+	/** All registered volumes that share RoomId (a logical room may be built from several boxes). */
+	const TArray<ARoomVolume*>& GetVolumesForRoomId(FName RoomId) const;
+
+	/** Every registered room volume, in registration order. */
+	const TArray<TObjectPtr<ARoomVolume>>& GetAllRooms() const { return Rooms; }
+
+	/** Door adjacency between rooms. Empty (IsValid() == false) before world begin play. */
+	const FSFWRoomGraph& GetRoomGraph() const { return RoomGraph; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	/** BVH node. Leaves reference a contiguous run of ItemOrder; inner nodes have two children. */
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+		int32 FirstItem = 0;
+		int32 NumItems = 0;
+
+		bool IsLeaf() const { return Left == INDEX_NONE; }
+	};
+
+	/** Max rooms per leaf before splitting. */
+	static constexpr int32 MaxLeafItems = 2;
+
+	void RebuildIfDirty() const;
+	int32 BuildNode(int32 Begin, int32 End) const;
+
+	/** Registered rooms with a valid RoomId. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ARoomVolume>> Rooms;
+
+	/** RoomId -> volumes. Entries are removed on EndPlay, so raw pointers stay valid. */
+	TMap<FName, TArray<ARoomVolume*>> VolumesById;
+
+	/** Level's baked cell grid, if any. */
+	TWeakObjectPtr<const ASFW_RoomBakeActor> BakedGrid;
+
+	/** Cells of BakedGrid that may answer lookups directly (FSFWRoomCellGrid::BuildInteriorMask). */
+	TBitArray<> GridInterior;
+
+	/** Copied from the bake actor, or built at world begin play. */
+	UPROPERTY(Transient)
+	FSFWRoomGraph RoomGraph;
+
+	/** Probe distance for doors when the level has no baked graph. */
+	static constexpr float RuntimePortalProbeDistance = 100.f;
+
+	// Lazily rebuilt hierarchy (queries are const).
+	mutable TArray<FNode> Nodes;
+	mutable TArray<int32> ItemOrder;
+	mutable TArray<FBox> ItemBounds;
+	mutable bool bTreeDirty = true;
+};
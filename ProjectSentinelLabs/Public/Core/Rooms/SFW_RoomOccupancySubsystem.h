@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomOccupancySubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_RoomOccupancySubsystem.generated.h"
+
+class AActor;
+class AController;
+class APawn;
+class ARoomVolume;
+class ASFW_PlayerState;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FSFWOnRoomOccupancyChanged, FName /*RoomId*/);
+
+/**
+ * Server-side occupancy ledger, keyed by RoomId.
+ *
+ * ARoomVolume overlap events feed it incrementally, so "which rooms have players"
+ * and "what is the worst sanity tier in this room" are plain reads instead of
+ * GetOverlappingActors sweeps. Aggregates are refreshed when a pawn enters or
+ * leaves, is (un)possessed, or when a player's sanity tier changes.
+ *
+ * Also owns the per-actor room event debounce (bounded, pruned as it grows).
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_RoomOccupancySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_RoomOccupancySubsystem* Get(const UObject* WorldContextObject);
+
+	// ---- Feeds (server) ----
+
+	/** Called by ARoomVolume for every begin/end overlap, before debouncing. */
+	void NotifyActorEnteredRoom(const ARoomVolume* Room, AActor* Actor);
+	void NotifyActorLeftRoom(const ARoomVolume* Room, AActor* Actor);
+
+	/** Called by ASFW_PlayerState when its SanityTier changes. */
+	void NotifySanityTierChanged(const ASFW_PlayerState* PlayerState);
+
+	/**
+	 * Doorway debounce: false if Actor already produced an event for Room within
+	 * DebounceSeconds. Stamps the event time when returning true.
+	 */
+	bool ShouldProcessRoomEvent(const ARoomVolume* Room, const AActor* Actor, float DebounceSeconds);
+
+	// ---- Queries ----
+
+	/** Non-safe rooms with at least one player inside. Maintained incrementally. */
+	const TArray<FName>& GetOccupiedRooms() const { return OccupiedRooms; }
+
+	/** Highest sanity tier (1..3) of the players in RoomId, 1 if empty. */
+	int32 GetRoomTier(FName RoomId) const;
+
+	/** Number of player-controlled pawns in RoomId. */
+	int32 GetNumPlayersInRoom(FName RoomId) const;
+
+	/** Appends every room with a player inside, safe rooms included. */
+	void GetRoomsWithPlayers(TArray<FName>& OutRooms) const;
+
+	/** Appends the player-controlled pawns in RoomId to OutPawns. */
+	void GetPlayerPawnsInRoom(FName RoomId, TArray<APawn*>& OutPawns) const;
+
+	/** Appends the player-controlled pawns that overlap no room volume (seams, outdoors). */
+	void GetPlayerPawnsOutsideRooms(TArray<APawn*>& OutPawns) const;
+
+	/** Fired when a room's player count, tier or occupied state changes (server). */
+	FSFWOnRoomOccupancyChanged OnOccupancyChanged;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FPawnOverlap
+	{
+		/** Volumes of this room the pawn overlaps (rooms can span several boxes). */
+		int32 Volumes = 0;
+		/** Of those, how many are not safe rooms. */
+		int32 TargetableVolumes = 0;
+	};
+
+	struct FRoomEntry
+	{
+		TMap<TWeakObjectPtr<APawn>, FPawnOverlap> Pawns;
+
+		// Aggregates over player-controlled pawns, refreshed by RefreshRoom.
+		int32 NumPlayers = 0;
+		int32 MaxTier = 1;
+		bool bTargetable = false;
+	};
+
+	void RefreshRoom(FName RoomId);
+	void RefreshRoomsForPawn(const APawn* Pawn);
+	void PruneDebounce(double Now);
+
+	UFUNCTION()
+	void HandlePawnControllerChanged(APawn* Pawn, AController* Controller);
+
+	TMap<FName, FRoomEntry> Rooms;
+
+	/** Reverse lookup so possession / tier changes only touch the pawn's rooms. */
+	TMap<TWeakObjectPtr<const APawn>, TArray<FName, TInlineAllocator<2>>> PawnRooms;
+
+	TArray<FName> OccupiedRooms;
+
+	// ---- Debounce ----
+	using FDebounceKey = TPair<TWeakObjectPtr<const ARoomVolume>, TWeakObjectPtr<const AActor>>;
+	TMap<FDebounceKey, double> LastEventTime;
+
+	/** Largest window seen; anything older can never block an event again. */
+	float MaxDebounceSeconds = 0.f;
+
+	/** Prune when the map reaches this size; grows if most entries are still live. */
+	int32 DebouncePruneThreshold = 64;
+};
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomPathCacheSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "SFW_RoomPathCacheSubsystem.generated.h"
+
+class APawn;
+
+/** Path for a RequestPath call; null when none was found. */
+DECLARE_DELEGATE_OneParam(FSFWOnRoomPathReady, FNavPathSharedPtr /*Path*/);
+
+/**
+ * Room-to-room navigation paths, found asynchronously and cached.
+ *
+ * A path found from room A to room B's anchor (its center, projected onto the
+ * navmesh once) is kept as a corridor. Later requests from anywhere in A reuse
+ * it. The requester joins the corridor at the furthest of its first points that
+ * it can reach in a straight line, checked with a navmesh raycast rather than a
+ * new A* search. On a miss, FindPathAsync runs off the game thread and its full
+ * result is cached. Corridors keep the full path points, so the nav link flags
+ * and ids that door links (ASFW_DoorBase) rely on survive a replay.
+ *
+ * Corridors are dropped when the navmesh finishes rebuilding, and near a door
+ * whenever the door opens, closes, locks or unlocks (ASFW_DoorBase).
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_RoomPathCacheSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_RoomPathCacheSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Navmesh point for RoomId: Hint projected once and remembered (not remembered for NAME_None). */
+	bool GetRoomAnchor(FName RoomId, const FVector& Hint, FVector& OutAnchor);
+
+	/**
+	 * Path for Querier from Start (inside FromRoomId) to Anchor (ToRoomId's anchor).
+	 * On a cache hit Callback runs before this returns and the result is 0; otherwise
+	 * returns the async query id, for CancelRequest.
+	 */
+	uint32 RequestPath(const APawn* Querier, FName FromRoomId, FName ToRoomId,
+		const FVector& Start, const FVector& Anchor, FSFWOnRoomPathReady Callback);
+
+	/** Drop a pending request; its callback never runs. */
+	void CancelRequest(uint32 QueryId);
+
+	/** Forget every corridor (anchors are kept). */
+	void InvalidateAll();
+
+	/** Forget corridors passing within Radius of Location. */
+	void InvalidateNear(const FVector& Location, float Radius);
+
+	/** How close a corridor must pass to a door for the door's state changes to drop it. */
+	static constexpr float DoorInvalidateRadius = 200.f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FPendingQuery
+	{
+		FName FromRoomId;
+		FName ToRoomId;
+		uint32 Generation = 0;
+		FSFWOnRoomPathReady Callback;
+	};
+
+	/** A door change since a query started; its result isn't cached if it passes nearby. */
+	struct FNearInvalidation
+	{
+		FVector Location = FVector::ZeroVector;
+		double RadiusSq = 0.0;
+		uint32 Generation = 0;
+	};
+
+	/** Cached corridor points from a room to another room's anchor. */
+	TMap<TPair<FName, FName>, TArray<FNavPathPoint>> Corridors;
+
+	TMap<FName, FVector> Anchors;
+
+	TMap<uint32, FPendingQuery> PendingQueries;
+
+	/** Bumped by every invalidation. */
+	uint32 Generation = 0;
+
+	/** Results of queries started before this generation (InvalidateAll) are never cached. */
+	uint32 FullInvalidationGeneration = 0;
+
+	/** InvalidateNear calls still newer than some pending query, oldest first. */
+	TArray<FNearInvalidation> RecentInvalidations;
+
+	static bool PassesNear(TConstArrayView<FNavPathPoint> Points, const FVector& Location, double RadiusSq);
+
+	/** Corridor points tried when joining a cached corridor, from the start of it. */
+	static constexpr int32 MaxJoinProbes = 8;
+
+	/** Querier's path from Start into Corridor, built by NavData like a search result (query data, active path). */
+	FNavPathSharedPtr JoinCorridor(const TArray<FNavPathPoint>& Corridor, const APawn* Querier, const ANavigationData& NavData,
+		const FVector& Start) const;
+
+	void OnPathQueryFinished(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+};
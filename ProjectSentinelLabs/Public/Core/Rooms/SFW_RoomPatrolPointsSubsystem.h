@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+// SFW_RoomPatrolPointsSubsystem.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SFW_RoomPatrolPointsSubsystem.generated.h"
+
+class ANavigationData;
+
+/**
+ * Fixed patrol points per room, sampled from the navmesh once per level.
+ *
+ * At world begin play, or once the navmesh finishes building if it wasn't ready
+ * then, each room gets a Poisson-disk set of navmesh points. The first bake that
+ * yields points is kept; later navmesh rebuilds don't re-bake. The points are at
+ * least MinPointSpacing apart and reachable from the room's candidate nearest its
+ * centre. Candidates come from a jittered grid over the
+ * room's volumes, visited in a per-room seeded order, so a level always bakes the
+ * same points.
+ *
+ * All sets share one flat array; a room's set is a slice of it. Picking a patrol
+ * destination is then an index into that slice, with no nav query per leg.
+ */
+UCLASS()
+class PROJECTSENTINELLABS_API USFW_RoomPatrolPointsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USFW_RoomPatrolPointsSubsystem* Get(const UObject* WorldContextObject);
+
+	/** RoomId's patrol points; empty for unknown rooms or before the bake. */
+	TConstArrayView<FVector> GetPatrolPoints(FName RoomId) const;
+
+	/** Minimum distance between two points of a room (cm). */
+	static constexpr float MinPointSpacing = 300.f;
+
+	/** Cap per room, so a huge room stays a small array. */
+	static constexpr int32 MaxPointsPerRoom = 32;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FRoomSpan
+	{
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+	/** Every room's points, back to back. */
+	TArray<FVector> Points;
+
+	TMap<FName, FRoomSpan> RoomSpans;
+
+	/** Height above a navmesh point at which room membership is tested (volumes may start above the floor). */
+	static constexpr float MembershipProbeHeight = 50.f;
+
+	/** True if any room got points. */
+	bool BakeAllRooms();
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+};